@@ -178,6 +178,7 @@ then
     adc_instance=$($YAML_PARSER "$MCU_DEF_FILE" hal.adc)
     main_timer_instance=$($YAML_PARSER "$MCU_DEF_FILE" hal.timers.main)
     pwm_timer_instance=$($YAML_PARSER "$MCU_DEF_FILE" hal.timers.pwm)
+    input_timer_instance=$($YAML_PARSER "$MCU_DEF_FILE" hal.timers.input)
 
     {
         printf "%s\n" "#define ADC_INSTANCE         $adc_instance"
@@ -185,6 +186,11 @@ then
         printf "%s\n" "#define PWM_TIMER_INSTANCE   $pwm_timer_instance"
     } >> "$OUT_FILE_HEADER"
 
+    if [[ $input_timer_instance != "null" ]]
+    then
+        printf "%s\n" "#define INPUT_TIMER_INSTANCE $input_timer_instance" >> "$OUT_FILE_HEADER"
+    fi
+
     pllm_8mhz=$($YAML_PARSER "$MCU_DEF_FILE" hal.clocks.hse8MHz.pllm)
     plln_8mhz=$($YAML_PARSER "$MCU_DEF_FILE" hal.clocks.hse8MHz.plln)
     pllq_8mhz=$($YAML_PARSER "$MCU_DEF_FILE" hal.clocks.hse8MHz.pllq)
@@ -46,6 +46,15 @@ fi
 
 printf "%s\n" "DEFINES += BOARD_STRING=\\\"$TARGET_NAME\\\"" >> "$OUT_FILE_MAKEFILE_DEFINES"
 
+#targets whose storage can't hold the default amount of presets set the limit
+#so that no RAM is reserved for the presets which can never be used
+presets=$($YAML_PARSER "$TARGET_DEF_FILE" presets)
+
+if [[ $presets != "null" ]]
+then
+    printf "%s\n" "DEFINES += MAX_NUMBER_OF_PRESETS=$presets" >> "$OUT_FILE_MAKEFILE_DEFINES"
+fi
+
 ########################################################################################################
 
 {
@@ -211,6 +220,24 @@ then
     printf "%s\n" "DEFINES += BUTTONS_SUPPORTED" >> "$OUT_FILE_MAKEFILE_DEFINES"
 
     digital_in_type=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.type)
+    sampling_rate=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.samplingRate)
+
+    if [[ $sampling_rate != "null" ]]
+    then
+        if [[ $($YAML_PARSER "$MCU_DEF_FILE" hal.timers.input) == "null" ]]
+        then
+            echo "Digital input sampling rate can be changed only on MCUs with dedicated input timer"
+            exit 1
+        fi
+
+        if [[ $sampling_rate -lt 1000 || $sampling_rate -gt 8000 ]]
+        then
+            echo "Digital input sampling rate must be in 1000-8000 Hz range"
+            exit 1
+        fi
+
+        printf "%s\n" "DEFINES += DIGITAL_IN_SAMPLING_RATE=$sampling_rate" >> "$OUT_FILE_MAKEFILE_DEFINES"
+    fi
 
     declare -i max_number_of_buttons
     max_number_of_buttons=0
@@ -221,11 +248,17 @@ then
 
         max_number_of_buttons=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.pins --length)
 
+        declare -a din_ports
+        declare -a din_indexes
+
         for ((i=0; i<max_number_of_buttons; i++))
         do
             port=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.pins.["$i"].port)
             index=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.pins.["$i"].index)
 
+            din_ports[$i]=$port
+            din_indexes[$i]=$index
+
             {
                 printf "%s\n" "#define DIN_PORT_${i} CORE_IO_PORT(${port})"
                 printf "%s\n" "#define DIN_PIN_${i} CORE_IO_PORT_INDEX(${index})"
@@ -235,6 +268,49 @@ then
         done
 
         printf "%s\n" "};" >> "$OUT_FILE_SOURCE_PINS"
+
+        #group button pins by port so that each port can be read only once
+        unique_ports=$(printf "%s\n" "${din_ports[@]}" | awk '!seen[$0]++')
+
+        declare -i number_of_din_ports
+        declare -i port_pin_entry
+        number_of_din_ports=0
+        port_pin_entry=0
+        din_port_entries=""
+
+        printf "%s\n" "const Board::detail::map::dInPortPin_t dInPortPins[MAX_NUMBER_OF_BUTTONS] = {" >> "$OUT_FILE_SOURCE_PINS"
+
+        for port in $unique_ports
+        do
+            declare -i mask
+            declare -i first_pin
+            mask=0
+            first_pin=$port_pin_entry
+
+            for ((i=0; i<max_number_of_buttons; i++))
+            do
+                if [[ "${din_ports[$i]}" == "$port" ]]
+                then
+                    printf "%s\n" "{ .buttonIndex = ${i}, .pinIndex = ${din_indexes[$i]} }," >> "$OUT_FILE_SOURCE_PINS"
+                    mask=$((mask | (1 << ${din_indexes[$i]})))
+                    port_pin_entry+=1
+                fi
+            done
+
+            din_port_entries+=$(printf "{ .port = CORE_IO_PORT(%s), .mask = 0x%X, .firstPin = %d, .numberOfPins = %d }," "$port" "$mask" "$first_pin" "$((port_pin_entry - first_pin))")
+            din_port_entries+=$'\n'
+            number_of_din_ports+=1
+        done
+
+        printf "%s\n" "};" >> "$OUT_FILE_SOURCE_PINS"
+
+        {
+            printf "%s\n" "const Board::detail::map::dInPort_t dInPorts[NUMBER_OF_DIN_PORTS] = {"
+            printf "%s" "$din_port_entries"
+            printf "%s\n" "};"
+        } >> "$OUT_FILE_SOURCE_PINS"
+
+        printf "%s\n" "DEFINES += NUMBER_OF_DIN_PORTS=$number_of_din_ports" >> "$OUT_FILE_MAKEFILE_DEFINES"
         printf "%s\n" "DEFINES += NATIVE_BUTTON_INPUTS" >> "$OUT_FILE_MAKEFILE_DEFINES"
 
         if [[ "$($YAML_PARSER "$TARGET_DEF_FILE" buttons.extPullups)" == "true" ]]
@@ -245,6 +321,7 @@ then
     then
         port=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.pins.data.port)
         index=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.pins.data.index)
+        data_pin="${port}${index}"
 
         {
             printf "%s\n" "#define SR_IN_DATA_PORT CORE_IO_PORT(${port})"
@@ -253,6 +330,7 @@ then
 
         port=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.pins.clock.port)
         index=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.pins.clock.index)
+        clock_pin="${port}${index}"
 
         {
             printf "%s\n" "#define SR_IN_CLK_PORT CORE_IO_PORT(${port})"
@@ -271,6 +349,55 @@ then
         max_number_of_buttons=$(( 8 * "$number_of_in_sr"))
 
         printf "%s\n" "DEFINES += NUMBER_OF_IN_SR=$number_of_in_sr" >> "$OUT_FILE_MAKEFILE_DEFINES"
+
+        spi=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.spi)
+
+        if [[ $spi != "null" ]]
+        then
+            if [[ $($YAML_PARSER "$MCU_DEF_FILE" arch) != "stm32" ]]
+            then
+                echo "SPI readout of input shift registers is supported only on STM32"
+                exit 1
+            fi
+
+            #clock pin is driven as SCK and data pin is read as MISO using the alternate
+            #function of selected SPI peripheral, so only these pins can be used
+            case $spi in
+                1)
+                    sck_pins="A5 B3"
+                    miso_pins="A6 B4"
+                    ;;
+
+                2)
+                    sck_pins="B10 B13"
+                    miso_pins="B14 C2"
+                    ;;
+
+                3)
+                    sck_pins="B3 C10"
+                    miso_pins="B4 C11"
+                    ;;
+
+                *)
+                    echo "SPI$spi can't be used to read input shift registers"
+                    exit 1
+                    ;;
+            esac
+
+            if [[ " $sck_pins " != *" $clock_pin "* ]]
+            then
+                echo "Clock pin of input shift registers must be SCK pin of SPI$spi: $sck_pins"
+                exit 1
+            fi
+
+            if [[ " $miso_pins " != *" $data_pin "* ]]
+            then
+                echo "Data pin of input shift registers must be MISO pin of SPI$spi: $miso_pins"
+                exit 1
+            fi
+
+            printf "%s\n" "DEFINES += SR_IN_SPI=$spi" >> "$OUT_FILE_MAKEFILE_DEFINES"
+        fi
     elif [[ $digital_in_type == matrix ]]
     then
         number_of_rows=0
@@ -348,6 +475,59 @@ then
             exit 1
         fi
 
+        if [[ $($YAML_PARSER "$TARGET_DEF_FILE" buttons.dma) == "true" ]]
+        then
+            if [[ $($YAML_PARSER "$MCU_DEF_FILE" arch) != "stm32" ]]
+            then
+                echo "DMA scanning of button matrix is supported only on STM32"
+                exit 1
+            fi
+
+            if [[ $($YAML_PARSER "$TARGET_DEF_FILE" buttons.rows.type) != "native" ]]
+            then
+                echo "DMA scanning of button matrix requires native rows"
+                exit 1
+            fi
+
+            #rows are read with single DMA transfer of input register and columns are
+            #switched with single write to set/reset register: all pins must share port
+            row_port=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.rows.pins.[0].port)
+            row_indexes=""
+
+            for ((i=0; i<number_of_rows; i++))
+            do
+                if [[ $($YAML_PARSER "$TARGET_DEF_FILE" buttons.rows.pins.["$i"].port) != "$row_port" ]]
+                then
+                    echo "DMA scanning of button matrix requires all row pins on the same port"
+                    exit 1
+                fi
+
+                row_indexes+="$($YAML_PARSER "$TARGET_DEF_FILE" buttons.rows.pins.["$i"].index),"
+            done
+
+            dec_port=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.columns.pins.decA0.port)
+
+            for ((i=0; i<3; i++))
+            do
+                if [[ $($YAML_PARSER "$TARGET_DEF_FILE" buttons.columns.pins.decA"$i".port) != "$dec_port" ]]
+                then
+                    echo "DMA scanning of button matrix requires all decoder pins on the same port"
+                    exit 1
+                fi
+
+                index=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.columns.pins.decA"$i".index)
+                printf "%s\n" "#define DEC_BM_INDEX_A${i} ${index}" >> "$OUT_FILE_HEADER_PINS"
+            done
+
+            {
+                printf "%s\n" "#define DIN_MATRIX_ROW_PORT CORE_IO_PORT(${row_port})"
+                printf "%s\n" "#define DEC_BM_PORT CORE_IO_PORT(${dec_port})"
+            } >> "$OUT_FILE_HEADER_PINS"
+
+            printf "%s\n" "const uint8_t dInMatrixRowBits[$number_of_rows] = { ${row_indexes} };" >> "$OUT_FILE_SOURCE_PINS"
+            printf "%s\n" "DEFINES += BUTTON_MATRIX_DMA" >> "$OUT_FILE_MAKEFILE_DEFINES"
+        fi
+
         max_number_of_buttons=$(("$number_of_columns" * "$number_of_rows"))
 
         {
@@ -360,7 +540,15 @@ then
     then
         max_number_of_buttons=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.indexing --length)
 
-        printf "%s\n" "const uint8_t buttonIndexes[MAX_NUMBER_OF_BUTTONS] = {" >> "$OUT_FILE_SOURCE_PINS"
+        #indexes don't fit into single byte with more than 256 components
+        index_type="uint8_t"
+
+        if [[ "$max_number_of_buttons" -gt 256 ]]
+        then
+            index_type="uint16_t"
+        fi
+
+        printf "%s\n" "const ${index_type} buttonIndexes[MAX_NUMBER_OF_BUTTONS] = {" >> "$OUT_FILE_SOURCE_PINS"
 
         for ((i=0; i<max_number_of_buttons; i++))
         do
@@ -380,9 +568,78 @@ then
             printf "%s\n" "DEFINES += ENCODERS_SUPPORTED"
             printf "%s\n" "DEFINES += MAX_NUMBER_OF_ENCODERS=$(("$max_number_of_buttons" / 2))"
         } >> "$OUT_FILE_MAKEFILE_DEFINES"
+
+        if [[ "$($YAML_PARSER "$TARGET_DEF_FILE" buttons.encoderTimers)" != "null" ]]
+        then
+            if [[ $($YAML_PARSER "$MCU_DEF_FILE" arch) != "stm32" ]]
+            then
+                echo "Hardware decoding of encoders is supported only on STM32"
+                exit 1
+            fi
+
+            if [[ $digital_in_type != native ]]
+            then
+                echo "Hardware decoding of encoders requires native buttons"
+                exit 1
+            fi
+
+            declare -i number_of_encoder_timers
+            number_of_encoder_timers=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.encoderTimers --length)
+
+            #timers already used by the board can't be used for encoders
+            used_timers="$($YAML_PARSER "$MCU_DEF_FILE" hal.timers.main) $($YAML_PARSER "$MCU_DEF_FILE" hal.timers.pwm) $($YAML_PARSER "$MCU_DEF_FILE" hal.timers.input)"
+
+            if [[ $($YAML_PARSER "$TARGET_DEF_FILE" buttons.dma) == "true" ]]
+            then
+                used_timers+=" TIM1"
+            fi
+
+            printf "%s\n" "const Board::detail::map::encoderTimer_t encoderTimers[NUMBER_OF_ENCODER_TIMERS] = {" >> "$OUT_FILE_SOURCE_PINS"
+
+            for ((i=0; i<number_of_encoder_timers; i++))
+            do
+                encoder=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.encoderTimers.["$i"].encoder)
+                timer=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.encoderTimers.["$i"].timer)
+                alternate=$($YAML_PARSER "$TARGET_DEF_FILE" buttons.encoderTimers.["$i"].alternate)
+
+                if [[ "$encoder" -ge $(("$max_number_of_buttons" / 2)) ]]
+                then
+                    echo "Encoder index $encoder is out of range"
+                    exit 1
+                fi
+
+                #only these timers have encoder interface
+                if [[ ! $timer =~ ^TIM(1|2|3|4|5|8)$ ]]
+                then
+                    echo "$timer can't be used to decode encoders"
+                    exit 1
+                fi
+
+                if [[ " $used_timers " == *" $timer "* ]]
+                then
+                    echo "$timer is already in use"
+                    exit 1
+                fi
+
+                used_timers+=" $timer"
+                printf "%s\n" "{ .encoderIndex = ${encoder}, .timer = ${timer}, .alternate = ${alternate} }," >> "$OUT_FILE_SOURCE_PINS"
+            done
+
+            printf "%s\n" "};" >> "$OUT_FILE_SOURCE_PINS"
+
+            {
+                printf "%s\n" "DEFINES += ENCODER_TIMERS"
+                printf "%s\n" "DEFINES += NUMBER_OF_ENCODER_TIMERS=$number_of_encoder_timers"
+            } >> "$OUT_FILE_MAKEFILE_DEFINES"
+        fi
     else
         printf "%s\n" "DEFINES += MAX_NUMBER_OF_ENCODERS=0" >> "$OUT_FILE_MAKEFILE_DEFINES"
     fi
+
+    if [[ $($YAML_PARSER "$TARGET_DEF_FILE" buttons.gestures) == "true" ]]
+    then
+        printf "%s\n" "DEFINES += BUTTON_GESTURES" >> "$OUT_FILE_MAKEFILE_DEFINES"
+    fi
 else
     {
         printf "%s\n" "DEFINES += MAX_NUMBER_OF_BUTTONS=0"
@@ -511,7 +768,14 @@ then
     then
         max_number_of_leds=$($YAML_PARSER "$TARGET_DEF_FILE" leds.external.indexing --length)
 
-        printf "%s\n" "const uint8_t ledIndexes[MAX_NUMBER_OF_LEDS] = {" >> "$OUT_FILE_SOURCE_PINS"
+        index_type="uint8_t"
+
+        if [[ "$max_number_of_leds" -gt 256 ]]
+        then
+            index_type="uint16_t"
+        fi
+
+        printf "%s\n" "const ${index_type} ledIndexes[MAX_NUMBER_OF_LEDS] = {" >> "$OUT_FILE_SOURCE_PINS"
 
         for ((i=0; i<max_number_of_leds; i++))
         do
@@ -615,6 +879,19 @@ then
         printf "%s\n" "DEFINES += ADC_UPPER_OFFSET_PERCENTAGE=$offset_upper"
     } >> "$OUT_FILE_MAKEFILE_DEFINES"
 
+    analog_filter=$($YAML_PARSER "$TARGET_DEF_FILE" analog.filter)
+
+    if [[ $analog_filter != "null" ]]
+    then
+        if [[ $analog_filter != "median" && $analog_filter != "runningMedian" && $analog_filter != "exponentialAverage" && $analog_filter != "oneEuro" ]]
+        then
+            echo "Unsupported analog filter: $analog_filter"
+            exit 1
+        fi
+
+        printf "%s\n" "DEFINES += ANALOG_FILTER_KERNEL=$analog_filter" >> "$OUT_FILE_MAKEFILE_DEFINES"
+    fi
+
     analog_in_type=$($YAML_PARSER "$TARGET_DEF_FILE" analog.type)
 
     declare -i max_number_of_analog
@@ -730,7 +1007,14 @@ then
     then
         max_number_of_analog=$($YAML_PARSER "$TARGET_DEF_FILE" analog.indexing --length)
 
-        printf "%s\n" "const uint8_t analogIndexes[MAX_NUMBER_OF_ANALOG] = {" >> "$OUT_FILE_SOURCE_PINS"
+        index_type="uint8_t"
+
+        if [[ "$max_number_of_analog" -gt 256 ]]
+        then
+            index_type="uint16_t"
+        fi
+
+        printf "%s\n" "const ${index_type} analogIndexes[MAX_NUMBER_OF_ANALOG] = {" >> "$OUT_FILE_SOURCE_PINS"
 
         for ((i=0; i<max_number_of_analog; i++))
         do
@@ -79,8 +79,7 @@ else
         ADC_10_BIT \
         ORDERED_EP_CONFIG \
         UID_BITS=80 \
-        MEDIAN_SAMPLE_COUNT=3 \
-        MEDIAN_MIDDLE_VALUE=1
+        MEDIAN_SAMPLE_COUNT=3
 
         #flash type specific
         ifeq ($(TYPE),boot)
@@ -17,6 +17,8 @@ limitations under the License.
 */
 
 #include "database/Database.h"
+#include "io/buttons/Buttons.h"
+#include "io/encoders/Encoders.h"
 #include "io/leds/LEDs.h"
 
 void Database::customInitButtons()
@@ -30,6 +32,15 @@ void Database::customInitButtons()
 
     for (int i = 0; i < MAX_NUMBER_OF_TOUCHSCREEN_COMPONENTS; i++)
         update(Database::Section::button_t::midiID, i + MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG, i);
+
+    for (size_t i = 0; i < IO::Buttons::DUAL_CONTACT_CURVE_POINTS; i++)
+        update(Database::Section::button_t::dualContactCurve, i, IO::Buttons::DUAL_CONTACT_CURVE_DEFAULT[i]);
+}
+
+void Database::customInitEncoders()
+{
+    for (size_t i = 0; i < IO::Encoders::ACCELERATION_CURVES * IO::Encoders::ACCELERATION_CURVE_POINTS; i++)
+        update(Database::Section::encoder_t::accelerationCurve, i, IO::Encoders::ACCELERATION_CURVE_DEFAULT[i]);
 }
 
 void Database::customInitAnalog()
@@ -125,6 +125,8 @@ bool Database::factoryReset()
     if (!clear())
         return false;
 
+    _stateRevision++;
+
     if (_initializeData)
     {
         //init system block first
@@ -181,6 +183,10 @@ bool Database::setPreset(uint8_t preset)
     if (preset >= _supportedPresets)
         return false;
 
+    //let the state of current preset be written while the layout still points to it
+    if (_handlers != nullptr)
+        _handlers->presetChangeStart(preset);
+
     _activePreset = preset;
 
     bool returnValue;
@@ -210,6 +216,7 @@ bool Database::setPresetInternal(uint8_t preset)
         return false;
 
     _activePreset = preset;
+    _revision++;
     LESSDB::setLayout(&dbLayout[1], static_cast<uint8_t>(block_t::AMOUNT), _userDataStartAddress + (_lastPresetAddress * _activePreset));
 
     return true;
@@ -315,6 +322,31 @@ void Database::registerHandlers(Handlers& handlers)
     _handlers = &handlers;
 }
 
+/// Moves the cursor to the next parameter in the active preset.
+/// Parameters are ordered by blocks, sections and indexes as defined in layout.
+/// param [in,out]: cursor  Cursor to advance.
+/// returns: True if cursor points to valid parameter, false if the end of preset has been reached.
+bool Database::nextParameter(parameterCursor_t& cursor)
+{
+    //system block isn't part of the preset
+    const LESSDB::block_t* block = &dbLayout[cursor.block + 1];
+
+    if (++cursor.parameter < block->section[cursor.section].numberOfParameters)
+        return true;
+
+    cursor.parameter = 0;
+
+    if (++cursor.section < block->numberOfSections)
+        return true;
+
+    cursor.section = 0;
+
+    if (++cursor.block < static_cast<uint8_t>(block_t::AMOUNT))
+        return true;
+
+    return false;
+}
+
 __attribute__((weak)) void Database::customInitGlobal()
 {
 }
@@ -20,19 +20,28 @@ limitations under the License.
 
 #include "dbms/src/LESSDB.h"
 
+#ifndef MAX_NUMBER_OF_PRESETS
+#define MAX_NUMBER_OF_PRESETS 10
+#endif
+
 class Database : public LESSDB
 {
     public:
     class Handlers
     {
         public:
-        Handlers()                                = default;
-        virtual void presetChange(uint8_t preset) = 0;
-        virtual void factoryResetStart()          = 0;
-        virtual void factoryResetDone()           = 0;
-        virtual void initialized()                = 0;
+        Handlers()                                     = default;
+        virtual void presetChangeStart(uint8_t preset) = 0;
+        virtual void presetChange(uint8_t preset)      = 0;
+        virtual void factoryResetStart()               = 0;
+        virtual void factoryResetDone()                = 0;
+        virtual void initialized()                     = 0;
     };
 
+    /// Largest amount of presets regardless of the available storage.
+    /// Targets with small storage lower the limit so that no RAM is reserved for unusable presets.
+    static constexpr uint8_t MAX_PRESETS = MAX_NUMBER_OF_PRESETS;
+
     Database(LESSDB::StorageAccess& storageAccess, bool initializeData)
         : LESSDB(storageAccess)
         , _initializeData(initializeData)
@@ -70,6 +79,14 @@ class Database : public LESSDB
             midiID,
             velocity,
             midiChannel,
+            dualContactCurve,
+            debounceProfile,
+            debouncePressSamples,
+            debounceReleaseSamples,
+            gestureLongPressTime,
+            gestureDoubleTapTime,
+            gestureRepeatTime,
+            gestureMidiID,
             AMOUNT
         };
 
@@ -83,6 +100,9 @@ class Database : public LESSDB
             pulsesPerStep,
             acceleration,
             remoteSync,
+            accelerationCurve,
+            value,
+            valueStored,
             AMOUNT
         };
 
@@ -138,8 +158,26 @@ class Database : public LESSDB
         };
     };
 
+    /// Position of single parameter within the active preset.
+    /// Default cursor points to the first parameter.
+    struct parameterCursor_t
+    {
+        uint8_t  block     = 0;
+        uint8_t  section   = 0;
+        uint16_t parameter = 0;
+    };
+
     using LESSDB::read;
-    using LESSDB::update;
+
+    bool update(uint8_t blockID, uint8_t sectionID, size_t parameterIndex, int32_t newValue)
+    {
+        _revision++;
+
+        if (isStateSection(blockID, sectionID))
+            _stateRevision++;
+
+        return LESSDB::update(blockID, sectionID, parameterIndex, newValue);
+    }
 
     template<typename T, typename I>
     int32_t read(T section, I index)
@@ -157,20 +195,47 @@ class Database : public LESSDB
 
     template<typename T, typename I, typename V>
     bool update(T section, I index, V value)
+    {
+        block_t blockIndex = block(section);
+        return update(static_cast<uint8_t>(blockIndex), static_cast<uint8_t>(section), static_cast<size_t>(index), static_cast<int32_t>(value));
+    }
+
+    /// Writes runtime state which is kept in database, but isn't part of configuration,
+    /// such as encoder values. Revision isn't changed since cached configuration stays valid.
+    template<typename T, typename I, typename V>
+    bool updateState(T section, I index, V value)
     {
         block_t blockIndex = block(section);
         return LESSDB::update(static_cast<uint8_t>(blockIndex), static_cast<uint8_t>(section), static_cast<size_t>(index), static_cast<int32_t>(value));
     }
 
-    bool    init();
-    bool    factoryReset();
-    uint8_t getSupportedPresets();
-    bool    setPreset(uint8_t preset);
-    uint8_t getPreset();
-    bool    setPresetPreserveState(bool state);
-    bool    getPresetPreserveState();
-    bool    isInitialized();
-    void    registerHandlers(Handlers& handlers);
+    bool     init();
+    bool     factoryReset();
+    uint8_t  getSupportedPresets();
+    bool     setPreset(uint8_t preset);
+    uint8_t  getPreset();
+    bool     setPresetPreserveState(bool state);
+    bool     getPresetPreserveState();
+    bool     isInitialized();
+    void     registerHandlers(Handlers& handlers);
+    bool     nextParameter(parameterCursor_t& cursor);
+    uint16_t getDbUID();
+
+    /// Returns the counter which changes on every write and preset change.
+    /// Used by components which keep parts of configuration in RAM to find out
+    /// whether their copy is still valid.
+    uint32_t revision()
+    {
+        return _revision;
+    }
+
+    /// Returns the counter which changes whenever the runtime state in database is overwritten
+    /// by anything other than updateState, ie. by factory reset or preset load.
+    /// Used by components which keep their state in RAM to find out whether it has to be read again.
+    uint32_t stateRevision()
+    {
+        return _stateRevision;
+    }
 
     void customInitGlobal();
     void customInitButtons();
@@ -216,8 +281,17 @@ class Database : public LESSDB
         return block_t::touchscreen;
     }
 
+    /// Checks whether the specified section holds runtime state instead of configuration.
+    bool isStateSection(uint8_t blockID, uint8_t sectionID)
+    {
+        if (blockID != static_cast<uint8_t>(block_t::encoders))
+            return false;
+
+        return (sectionID == static_cast<uint8_t>(Section::encoder_t::value)) ||
+               (sectionID == static_cast<uint8_t>(Section::encoder_t::valueStored));
+    }
+
     bool     isSignatureValid();
-    uint16_t getDbUID();
     bool     setDbUID(uint16_t uid);
     bool     setPresetInternal(uint8_t preset);
 
@@ -240,4 +314,7 @@ class Database : public LESSDB
     uint8_t _activePreset = 0;
 
     bool _initialized = false;
+
+    uint32_t _revision      = 0;
+    uint32_t _stateRevision = 0;
 };
\ No newline at end of file
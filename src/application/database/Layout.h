@@ -19,13 +19,13 @@ limitations under the License.
 #pragma once
 
 #include "Database.h"
+#include "io/buttons/Buttons.h"
+#include "io/encoders/Encoders.h"
 #include "io/leds/LEDs.h"
 #include "io/display/Display.h"
 #include "io/touchscreen/Touchscreen.h"
 #include "system/System.h"
 
-#define MAX_PRESETS 10
-
 namespace SectionPrivate
 {
     enum class system_t : uint8_t
@@ -97,7 +97,7 @@ namespace
         //type section
         {
             .numberOfParameters     = MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_COMPONENTS,
-            .parameterType          = LESSDB::sectionParameterType_t::bit,
+            .parameterType          = LESSDB::sectionParameterType_t::halfByte,
             .preserveOnPartialReset = false,
             .defaultValue           = 0,
             .autoIncrement          = false,
@@ -142,6 +142,86 @@ namespace
             .defaultValue           = 0,
             .autoIncrement          = false,
             .address                = 0,
+        },
+
+        //dual contact velocity curve section
+        {
+            .numberOfParameters     = IO::Buttons::DUAL_CONTACT_CURVE_POINTS,
+            .parameterType          = LESSDB::sectionParameterType_t::word,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //debounce profile section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_BUTTONS,
+            .parameterType          = LESSDB::sectionParameterType_t::halfByte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //debounce press samples section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_BUTTONS,
+            .parameterType          = LESSDB::sectionParameterType_t::byte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 1,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //debounce release samples section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_BUTTONS,
+            .parameterType          = LESSDB::sectionParameterType_t::byte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 5,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //gesture long press time section
+        {
+            .numberOfParameters     = IO::Buttons::GESTURE_BUTTONS,
+            .parameterType          = LESSDB::sectionParameterType_t::byte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //gesture double tap time section
+        {
+            .numberOfParameters     = IO::Buttons::GESTURE_BUTTONS,
+            .parameterType          = LESSDB::sectionParameterType_t::byte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //gesture repeat time section
+        {
+            .numberOfParameters     = IO::Buttons::GESTURE_BUTTONS,
+            .parameterType          = LESSDB::sectionParameterType_t::byte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //gesture midi id section
+        {
+            .numberOfParameters     = IO::Buttons::GESTURE_BUTTONS,
+            .parameterType          = LESSDB::sectionParameterType_t::byte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
         }
     };
 
@@ -217,6 +297,36 @@ namespace
         },
 
         //remote sync section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_ENCODERS,
+            .parameterType          = LESSDB::sectionParameterType_t::bit,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //acceleration curve section
+        {
+            .numberOfParameters     = IO::Encoders::ACCELERATION_CURVES * IO::Encoders::ACCELERATION_CURVE_POINTS,
+            .parameterType          = LESSDB::sectionParameterType_t::byte,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //stored value section
+        {
+            .numberOfParameters     = MAX_NUMBER_OF_ENCODERS,
+            .parameterType          = LESSDB::sectionParameterType_t::word,
+            .preserveOnPartialReset = false,
+            .defaultValue           = 0,
+            .autoIncrement          = false,
+            .address                = 0,
+        },
+
+        //value stored section
         {
             .numberOfParameters     = MAX_NUMBER_OF_ENCODERS,
             .parameterType          = LESSDB::sectionParameterType_t::bit,
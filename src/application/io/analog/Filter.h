@@ -22,18 +22,26 @@ limitations under the License.
 #include "stub/Filter.h"
 #else
 
-#include <stdio.h>
 #include <stdlib.h>
 #include "core/src/general/Timing.h"
 #include "io/analog/Analog.h"
+#include "io/analog/FilterKernels.h"
 #include "core/src/general/Helpers.h"
 
+//Kernel used to filter the readings from analog inputs.
+//See IO::FilterKernel::type_t for available kernels.
+#ifndef ANALOG_FILTER_KERNEL
+#define ANALOG_FILTER_KERNEL median
+#endif
+
+//Amount of samples from which median is calculated in median kernels.
 #ifndef MEDIAN_SAMPLE_COUNT
 #define MEDIAN_SAMPLE_COUNT 5
 #endif
 
-#ifndef MEDIAN_MIDDLE_VALUE
-#define MEDIAN_MIDDLE_VALUE 3
+//Weight of new sample in exponential moving average kernel, as 1/2^n.
+#ifndef EXPONENTIAL_AVERAGE_SHIFT
+#define EXPONENTIAL_AVERAGE_SHIFT 2
 #endif
 
 //Define if analog MIDI values can't reach 0.
@@ -101,16 +109,8 @@ namespace IO
                 return true;
             }
 
-            auto compare = [](const void* a, const void* b) {
-                if (*(uint16_t*)a < *(uint16_t*)b)
-                    return -1;
-                else if (*(uint16_t*)a > *(uint16_t*)b)
-                    return 1;
-
-                return 0;
-            };
-
-            const bool     fastFilter = (index < MAX_NUMBER_OF_ANALOG) ? (core::timing::currentRunTimeMs() - _lastStableMovementTime[index]) < FAST_FILTER_ENABLE_AFTER_MS : true;
+            const uint32_t now        = core::timing::currentRunTimeMs();
+            const bool     fastFilter = (index < MAX_NUMBER_OF_ANALOG) ? (now - _lastStableMovementTime[index]) < FAST_FILTER_ENABLE_AFTER_MS : true;
             const bool     use14bit   = (type == Analog::type_t::nrpn14bit) || (type == Analog::type_t::pitchBend) || (type == Analog::type_t::controlChange14bit);
             const uint16_t maxLimit   = use14bit ? MIDI::MIDI_14_BIT_VALUE_MAX : MIDI::MIDI_7_BIT_VALUE_MAX;
             const bool     direction  = value >= _lastStableValue[index];
@@ -119,7 +119,7 @@ namespace IO
             if (abs(value - _lastStableValue[index]) < stepDiff)
             {
                 if (index < MAX_NUMBER_OF_ANALOG)
-                    _medianSampleCounter[index] = 0;
+                    _kernel[index].track(value, now);
 
                 return false;
             }
@@ -130,22 +130,12 @@ namespace IO
 
                 if (!fastFilter)
                 {
-                    _analogSample[index][_medianSampleCounter[index]++] = value;
-
-                    //take the median value to avoid using outliers
-                    if (_medianSampleCounter[index] == MEDIAN_SAMPLE_COUNT)
-                    {
-                        qsort(_analogSample[index], MEDIAN_SAMPLE_COUNT, sizeof(uint16_t), compare);
-                        _medianSampleCounter[index] = 0;
-                        filteredValue               = _analogSample[index][MEDIAN_MIDDLE_VALUE];
-                    }
-                    else
-                    {
+                    if (!_kernel[index].process(value, now, filteredValue))
                         return false;
-                    }
                 }
                 else
                 {
+                    _kernel[index].track(value, now);
                     filteredValue = value;
                 }
             }
@@ -164,7 +154,7 @@ namespace IO
             _lastStableValue[index]     = filteredValue;
 
             if (index < MAX_NUMBER_OF_ANALOG)
-                _lastStableMovementTime[index] = core::timing::currentRunTimeMs();
+                _lastStableMovementTime[index] = now;
 
             if (type == Analog::type_t::fsr)
             {
@@ -186,7 +176,7 @@ namespace IO
         {
             if (index < MAX_NUMBER_OF_ANALOG)
             {
-                _medianSampleCounter[index]    = 0;
+                _kernel[index].reset();
                 _lastStableMovementTime[index] = 0;
             }
 
@@ -194,6 +184,8 @@ namespace IO
         }
 
         private:
+        using kernel_t = FilterKernel::kernel_t<FilterKernel::type_t::ANALOG_FILTER_KERNEL, MEDIAN_SAMPLE_COUNT, EXPONENTIAL_AVERAGE_SHIFT>;
+
         using adcConfig_t = struct
         {
             const uint16_t adcMinValue;                 ///< Minimum raw ADC value.
@@ -235,8 +227,7 @@ namespace IO
         uint32_t                  _adcMinValueOffset                                                                = 0;
         uint32_t                  _adcMaxValueOffset                                                                = 0;
         static constexpr uint32_t FAST_FILTER_ENABLE_AFTER_MS                                                       = 100;
-        uint16_t                  _analogSample[MAX_NUMBER_OF_ANALOG][MEDIAN_SAMPLE_COUNT]                          = {};
-        size_t                    _medianSampleCounter[MAX_NUMBER_OF_ANALOG]                                        = {};
+        kernel_t                  _kernel[MAX_NUMBER_OF_ANALOG]                                                     = {};
         uint32_t                  _lastStableMovementTime[MAX_NUMBER_OF_ANALOG]                                     = {};
         bool                      _lastStableDirection[MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_COMPONENTS] = {};
         uint16_t                  _lastStableValue[MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_COMPONENTS]     = {};
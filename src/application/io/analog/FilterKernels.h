@@ -0,0 +1,332 @@
+/*
+
+Copyright 2015-2021 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <type_traits>
+
+namespace IO
+{
+    /// Kernels used to smooth the readings from analog inputs.
+    /// Every kernel filters single input and provides the same interface:
+    ///  process(value, time, filteredValue)    Adds new sample. Returns true and sets filteredValue
+    ///                                         once the filtered value is available.
+    ///  track(value, time)                     Adds sample whose filtered value isn't needed.
+    ///  reset()                                Forgets all the samples.
+    namespace FilterKernel
+    {
+        enum class type_t : uint8_t
+        {
+            median,                ///< Median of every N samples.
+            runningMedian,         ///< Median of the last N samples, available on every sample.
+            exponentialAverage,    ///< Exponential moving average.
+            oneEuro,               ///< Low-pass filter whose cutoff rises with the speed of change.
+        };
+
+        /// Orders two samples so that the smaller one ends up in a.
+        inline void compareSwap(uint16_t& a, uint16_t& b)
+        {
+            if (a > b)
+            {
+                const uint16_t temp = a;
+
+                a = b;
+                b = temp;
+            }
+        }
+
+        /// Calculates median using the sorting network with the smallest amount of comparisons
+        /// for 3, 5 or 7 samples (3, 7 and 13 comparisons). Samples are partially reordered.
+        template<size_t size>
+        uint16_t median(uint16_t (&sample)[size])
+        {
+            static_assert((size == 3) || (size == 5) || (size == 7), "Median network is defined only for 3, 5 and 7 samples");
+
+            if constexpr (size == 3)
+            {
+                compareSwap(sample[0], sample[1]);
+                compareSwap(sample[1], sample[2]);
+                compareSwap(sample[0], sample[1]);
+            }
+            else if constexpr (size == 5)
+            {
+                compareSwap(sample[0], sample[1]);
+                compareSwap(sample[3], sample[4]);
+                compareSwap(sample[0], sample[3]);
+                compareSwap(sample[1], sample[4]);
+                compareSwap(sample[1], sample[2]);
+                compareSwap(sample[2], sample[3]);
+                compareSwap(sample[1], sample[2]);
+            }
+            else
+            {
+                compareSwap(sample[0], sample[5]);
+                compareSwap(sample[0], sample[3]);
+                compareSwap(sample[1], sample[6]);
+                compareSwap(sample[2], sample[4]);
+                compareSwap(sample[0], sample[1]);
+                compareSwap(sample[3], sample[5]);
+                compareSwap(sample[2], sample[6]);
+                compareSwap(sample[2], sample[3]);
+                compareSwap(sample[3], sample[6]);
+                compareSwap(sample[4], sample[5]);
+                compareSwap(sample[1], sample[4]);
+                compareSwap(sample[1], sample[3]);
+                compareSwap(sample[3], sample[4]);
+            }
+
+            return sample[size / 2];
+        }
+
+        /// Median of every size samples. Filtered value is available once per size samples.
+        template<size_t size>
+        class Median
+        {
+            public:
+            bool process(uint16_t value, uint32_t time, uint16_t& filteredValue)
+            {
+                _sample[_count++] = value;
+
+                if (_count < size)
+                    return false;
+
+                _count        = 0;
+                filteredValue = median(_sample);
+
+                return true;
+            }
+
+            /// Samples which aren't filtered break the window so it's started again.
+            void track(uint16_t value, uint32_t time)
+            {
+                reset();
+            }
+
+            void reset()
+            {
+                _count = 0;
+            }
+
+            private:
+            uint16_t _sample[size] = {};
+            uint8_t  _count        = 0;
+        };
+
+        /// Median of the last size samples. Filtered value is available on every sample
+        /// once the window is filled.
+        /// Window is kept sorted: the oldest sample is replaced with the new one which is then
+        /// moved into its place. Readings change slowly so it usually moves by a position or two
+        /// and the cost per sample doesn't depend on window size like sorting does.
+        template<size_t size>
+        class RunningMedian
+        {
+            static_assert(size && (size < 0xFF), "Invalid window size");
+
+            public:
+            bool process(uint16_t value, uint32_t time, uint16_t& filteredValue)
+            {
+                size_t position;
+
+                if (_count < size)
+                {
+                    //window not filled yet, append the sample
+                    position = _count++;
+                }
+                else
+                {
+                    //replace the oldest sample
+                    position = 0;
+
+                    while (_sorted[position] != _window[_oldest])
+                        position++;
+                }
+
+                _sorted[position] = value;
+                _window[_oldest]  = value;
+                _oldest           = (_oldest + 1) % size;
+
+                while ((position > 0) && (_sorted[position - 1] > _sorted[position]))
+                {
+                    compareSwap(_sorted[position - 1], _sorted[position]);
+                    position--;
+                }
+
+                while (((position + 1) < _count) && (_sorted[position] > _sorted[position + 1]))
+                {
+                    compareSwap(_sorted[position], _sorted[position + 1]);
+                    position++;
+                }
+
+                if (_count < size)
+                    return false;
+
+                filteredValue = _sorted[size / 2];
+                return true;
+            }
+
+            /// Samples which aren't filtered break the window so it's started again.
+            void track(uint16_t value, uint32_t time)
+            {
+                reset();
+            }
+
+            void reset()
+            {
+                _count  = 0;
+                _oldest = 0;
+            }
+
+            private:
+            uint16_t _window[size] = {};    ///< Samples in the order in which they have been added.
+            uint16_t _sorted[size] = {};    ///< The same samples in ascending order.
+            uint8_t  _count        = 0;
+            uint8_t  _oldest       = 0;
+        };
+
+        /// Exponential moving average in fixed point. Every sample moves the average
+        /// by 1/2^shift of the difference between the sample and the average.
+        template<uint8_t shift>
+        class ExponentialAverage
+        {
+            static_assert((shift > 0) && (shift < 16), "Invalid shift");
+
+            public:
+            bool process(uint16_t value, uint32_t time, uint16_t& filteredValue)
+            {
+                if (!_initialized)
+                {
+                    _average     = static_cast<uint32_t>(value) << shift;
+                    _initialized = true;
+                }
+                else
+                {
+                    //rounding avoids settling next to the input when approaching it from above
+                    _average = _average - ((_average + HALF) >> shift) + value;
+                }
+
+                filteredValue = (_average + HALF) >> shift;
+                return true;
+            }
+
+            /// Average follows the input even when the filtered value isn't used
+            /// so that it doesn't jump once it's used again.
+            void track(uint16_t value, uint32_t time)
+            {
+                uint16_t filteredValue;
+                process(value, time, filteredValue);
+            }
+
+            void reset()
+            {
+                _initialized = false;
+            }
+
+            private:
+            static constexpr uint32_t HALF = static_cast<uint32_t>(1) << (shift - 1);
+
+            uint32_t _average     = 0;    ///< Average multiplied by 2^shift.
+            bool     _initialized = false;
+        };
+
+        /// 1€ filter (Casiez, Roussel, Vogel, 2012). Low-pass filter whose cutoff frequency
+        /// rises with the speed of change: slow movement is heavily smoothed to remove jitter
+        /// while fast movement is smoothed less so that it isn't delayed.
+        /// Uses floating point math, so it's meant for targets with FPU.
+        class OneEuro
+        {
+            public:
+            bool process(uint16_t value, uint32_t time, uint16_t& filteredValue)
+            {
+                if (!_initialized)
+                {
+                    _value       = value;
+                    _derivative  = 0;
+                    _lastTime    = time;
+                    _initialized = true;
+                }
+                else
+                {
+                    //several samples can be taken within the same millisecond
+                    const uint32_t elapsed = (time - _lastTime) ? (time - _lastTime) : 1;
+                    const float    period  = elapsed / 1000.0f;
+                    const float    change  = (value - _value) / period;
+
+                    _lastTime = time;
+                    _derivative += alpha(period, DERIVATIVE_CUTOFF) * (change - _derivative);
+
+                    const float speed = _derivative < 0 ? -_derivative : _derivative;
+
+                    _value += alpha(period, MIN_CUTOFF + (BETA * speed)) * (value - _value);
+                }
+
+                filteredValue = static_cast<uint16_t>(_value + 0.5f);
+                return true;
+            }
+
+            /// Filter follows the input even when the filtered value isn't used
+            /// so that it doesn't jump once it's used again.
+            void track(uint16_t value, uint32_t time)
+            {
+                uint16_t filteredValue;
+                process(value, time, filteredValue);
+            }
+
+            void reset()
+            {
+                _initialized = false;
+            }
+
+            private:
+            /// Cutoff frequency in Hz used when the reading isn't changing.
+            static constexpr float MIN_CUTOFF = 1.0f;
+
+            /// Increase of cutoff frequency in Hz per ADC unit per second of change.
+            static constexpr float BETA = 0.01f;
+
+            /// Cutoff frequency in Hz used to smooth the speed of change.
+            static constexpr float DERIVATIVE_CUTOFF = 1.0f;
+
+            /// Smoothing factor of low-pass filter with given cutoff frequency.
+            static float alpha(float period, float cutoff)
+            {
+                const float tau = 1.0f / (2.0f * 3.14159265f * cutoff);
+                return 1.0f / (1.0f + (tau / period));
+            }
+
+            float    _value       = 0;
+            float    _derivative  = 0;
+            uint32_t _lastTime    = 0;
+            bool     _initialized = false;
+        };
+
+        /// Kernel of selected type.
+        /// param [in]: type            Type of kernel.
+        /// param [in]: samples         Window size for median kernels.
+        /// param [in]: averageShift    Weight of new sample for exponential moving average, as 1/2^averageShift.
+        template<type_t type, size_t samples, uint8_t averageShift>
+        using kernel_t = typename std::conditional<type == type_t::median,
+                                                   Median<samples>,
+                                                   typename std::conditional<type == type_t::runningMedian,
+                                                                             RunningMedian<samples>,
+                                                                             typename std::conditional<type == type_t::exponentialAverage,
+                                                                                                       ExponentialAverage<averageShift>,
+                                                                                                       OneEuro>::type>::type>::type;
+    }    // namespace FilterKernel
+}    // namespace IO
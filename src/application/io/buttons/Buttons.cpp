@@ -36,71 +36,117 @@ Buttons::Buttons(HWA&                     hwa,
                        Util::MessageDispatcher::listenType_t::forward,
                        [this](const Util::MessageDispatcher::message_t& dispatchMessage) {
                            size_t             index = dispatchMessage.componentIndex + MAX_NUMBER_OF_BUTTONS;
-                           buttonDescriptor_t descriptor;
-                           fillButtonDescriptor(index, descriptor);
+                           action_t           action;
+                           buildAction(index, action);
 
                            // dispatchMessage.midiValue in this case contains state information only
-                           processButton(index, dispatchMessage.midiValue, descriptor);
+                           processButton(index, dispatchMessage.midiValue, action);
                        });
 
     _dispatcher.listen(Util::MessageDispatcher::messageSource_t::touchscreenButton,
                        Util::MessageDispatcher::listenType_t::forward,
                        [this](const Util::MessageDispatcher::message_t& dispatchMessage) {
                            size_t             index = dispatchMessage.componentIndex + MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG;
-                           buttonDescriptor_t descriptor;
-                           fillButtonDescriptor(index, descriptor);
+                           action_t           action;
+                           buildAction(index, action);
 
                            // dispatchMessage.midiValue in this case contains state information only
-                           processButton(index, dispatchMessage.midiValue, descriptor);
+                           processButton(index, dispatchMessage.midiValue, action);
                        });
 }
 
 /// Continuously reads inputs from buttons and acts if necessary.
 void Buttons::update(bool forceResend)
 {
-    for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+    if (forceResend)
     {
+        for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+        {
+            //second contact doesn't send anything on its own
+            if (isSecondContact(i))
+                continue;
+
+            const action_t& action = cachedAction(i);
+
+            if ((action.type == type_t::latching) || (action.type == type_t::dualContact))
+                sendMessage(i, latchingState(i), action);
+            else
+                sendMessage(i, state(i), action);
+        }
+
+        return;
+    }
+
+#ifdef BUTTON_GESTURES
+    //only the buttons whose gesture timer has expired are visited here
+    _gestureTimers.advance(core::timing::currentRunTimeMs() / GESTURE_TICK_MS, [this](size_t index) {
+        gestureTimeout(index);
+    });
+#endif
+
+    changedBitmap_t changed;
+    bool            anyChanged = _hwa.changed(changed);
+
+    //buttons which are still being debounced need to be checked even without new changes
+    for (size_t word = 0; word < changed.size(); word++)
+    {
+        changed[word] |= _debouncePending[word];
+
+        if (changed[word])
+            anyChanged = true;
+    }
+
+    //visit only the buttons which could have changed state
+    if (!anyChanged)
+        return;
+
+    Common::forEachSetBit(changed, [this](size_t index) {
+        if (index >= MAX_NUMBER_OF_BUTTONS)
+            return;
+
         uint8_t  numberOfReadings = 0;
         uint32_t states           = 0;
+        bool     debounced        = false;
 
-        buttonDescriptor_t descriptor;
-        fillButtonDescriptor(i, descriptor);
+        if (!_hwa.state(index, numberOfReadings, states, debounced))
+            return;
 
-        if (!forceResend)
-        {
-            if (!_hwa.state(i, numberOfReadings, states))
-                continue;
+        //second contact of dual contact button uses the configuration of the first contact
+        size_t          buttonIndex = isSecondContact(index) ? index - 1 : index;
+        bool            raw         = states & 0x01;
+        const action_t& action      = cachedAction(buttonIndex);
 
-            //this filter will return amount of stable changed readings
-            //and the states of those readings
-            //latest reading is index 0
-            if (!_filter.isFiltered(i, numberOfReadings, states))
-                continue;
+        //this filter will return amount of stable changed readings
+        //and the states of those readings
+        //latest reading is index 0
+        if (!_filter.isFiltered(index, action.debounce, debounced, numberOfReadings, states))
+            return;
 
-            for (uint8_t reading = 0; reading < numberOfReadings; reading++)
-            {
-                //when processing, newest sample has index 0
-                //start from oldest reading which is in upper bits
-                uint8_t processIndex = numberOfReadings - 1 - reading;
-                bool    state        = (states >> processIndex) & 0x01;
-
-                processButton(i, state, descriptor);
-            }
-        }
+        //filter could still change the state once the raw reading has been stable for long enough
+        if (static_cast<bool>(states & 0x01) != raw)
+            _debouncePending[index / 32] |= (static_cast<uint32_t>(1) << (index % 32));
         else
+            _debouncePending[index / 32] &= ~(static_cast<uint32_t>(1) << (index % 32));
+
+        for (uint8_t reading = 0; reading < numberOfReadings; reading++)
         {
-            if (descriptor.type == type_t::latching)
-                sendMessage(i, latchingState(i), descriptor);
+            //when processing, newest sample has index 0
+            //start from oldest reading which is in upper bits
+            uint8_t processIndex = numberOfReadings - 1 - reading;
+            bool    state        = (states >> processIndex) & 0x01;
+
+            if (action.type == type_t::dualContact)
+                processDualContact(buttonIndex, index, state, action);
             else
-                sendMessage(i, state(i), descriptor);
+                processButton(index, state, action);
         }
-    }
+    });
 }
 
 /// Handles changes in button states.
 /// param [in]: index       Button index which has changed state.
-/// param [in]: descriptor  Descriptor containing the entire configuration for the button.
-void Buttons::processButton(size_t index, bool reading, buttonDescriptor_t& descriptor)
+/// param [in]: action      Resolved configuration of the button.
+void Buttons::processButton(size_t index, bool reading, const action_t& action)
 {
     //act on change of state only
     if (reading == state(index))
@@ -109,9 +155,9 @@ void Buttons::processButton(size_t index, bool reading, buttonDescriptor_t& desc
     setState(index, reading);
 
     //don't process messageType_t::none type of message
-    if (descriptor.messageType != messageType_t::none)
+    if (action.messageType != messageType_t::none)
     {
-        if (descriptor.messageType == messageType_t::presetOpenDeck)
+        if (action.messageType == messageType_t::presetOpenDeck)
         {
             //change preset only on press
             if (reading)
@@ -119,14 +165,14 @@ void Buttons::processButton(size_t index, bool reading, buttonDescriptor_t& desc
                 //don't send off message once the preset is switched (in case this button has standard message type in switched preset)
                 //pretend the button is already released
                 setState(index, false);
-                _database.setPreset(descriptor.dispatchMessage.midiIndex);
+                _database.setPreset(action.midiIndex);
             }
         }
         else
         {
             bool sendMIDI = true;
 
-            if (descriptor.type == type_t::latching)
+            if (action.type == type_t::latching)
             {
                 //act on press only
                 if (reading)
@@ -150,180 +196,422 @@ void Buttons::processButton(size_t index, bool reading, buttonDescriptor_t& desc
             }
 
             if (sendMIDI)
-                sendMessage(index, reading, descriptor);
+                sendMessage(index, reading, action);
+
+#ifdef BUTTON_GESTURES
+            processGesture(index, reading, action);
+#endif
         }
     }
 }
 
-/// Used to send MIDI message from specified button.
-/// Used internally once the button state has been changed and processed.
-/// param [in]: index           Button index which sends the message.
-/// param [in]: descriptor      Structure holding all the information about button for specified index.
-void Buttons::sendMessage(size_t index, bool state, buttonDescriptor_t& descriptor)
+#ifdef BUTTON_GESTURES
+/// Tracks long press, double tap and hold-repeat gestures of momentary buttons.
+/// Regular message is always sent on press and release, gestures send additional message
+/// with the same type and channel, but with the gesture MIDI ID. Times are configured
+/// in GESTURE_TICK_MS units, with 0 disabling the gesture. Message types which derive
+/// MIDI ID from internal state (eg. program change increment) send the same message for gestures.
+/// param [in]: index       Button index which has changed state.
+/// param [in]: reading     New state of the button.
+/// param [in]: action      Resolved configuration of the button.
+void Buttons::processGesture(size_t index, bool reading, const action_t& action)
 {
-    bool send = true;
+    if ((index >= GESTURE_BUTTONS) || (action.type != type_t::momentary))
+        return;
 
-    if (state)
+    if (reading)
     {
-        switch (descriptor.messageType)
+        if (_gestureState[index] == gestureState_t::released)
         {
-        case messageType_t::note:
-        case messageType_t::controlChange:
-        case messageType_t::controlChangeReset:
-        case messageType_t::realTimeClock:
-        case messageType_t::realTimeStart:
-        case messageType_t::realTimeContinue:
-        case messageType_t::realTimeStop:
-        case messageType_t::realTimeActiveSensing:
-        case messageType_t::realTimeSystemReset:
-        case messageType_t::mmcPlay:
-        case messageType_t::mmcStop:
-        case messageType_t::mmcPause:
-        case messageType_t::mmcRecord:
-            break;
-
-        case messageType_t::programChange:
-        case messageType_t::programChangeInc:
-        case messageType_t::programChangeDec:
-        {
-            descriptor.dispatchMessage.midiValue = 0;
-
-            if (descriptor.messageType != messageType_t::programChange)
-            {
-                if (descriptor.messageType == messageType_t::programChangeInc)
-                {
-                    if (!Common::pcIncrement(descriptor.dispatchMessage.midiChannel))
-                        send = false;
-                }
-                else
-                {
-                    if (!Common::pcDecrement(descriptor.dispatchMessage.midiChannel))
-                        send = false;
-                }
-
-                descriptor.dispatchMessage.midiIndex = Common::program(descriptor.dispatchMessage.midiChannel);
-            }
+            //second press within double tap time
+            _gestureTimers.cancel(index);
+            _gestureState[index] = gestureState_t::doubleTapped;
+            sendGesture(index, true);
+            return;
         }
-        break;
 
-        case messageType_t::multiValIncResetNote:
-        {
-            uint8_t currentValue = Common::currentValue(index);
-            uint8_t value        = Common::valueInc(index, descriptor.dispatchMessage.midiValue, Common::incDecType_t::reset);
+        _gestureState[index] = gestureState_t::pressed;
 
-            if (currentValue != value)
-            {
-                if (!value)
-                    descriptor.dispatchMessage.message = MIDI::messageType_t::noteOff;
-                else
-                    descriptor.dispatchMessage.message = MIDI::messageType_t::noteOn;
+        //without long press, repeating starts once the button has been held for repeat time
+        if (action.gesture.longPressTime)
+            _gestureTimers.arm(index, action.gesture.longPressTime);
+        else if (action.gesture.repeatTime)
+            _gestureTimers.arm(index, action.gesture.repeatTime);
+    }
+    else
+    {
+        _gestureTimers.cancel(index);
 
-                descriptor.dispatchMessage.midiValue = currentValue;
-            }
-            else
-            {
-                send = false;
-            }
+        switch (_gestureState[index])
+        {
+        case gestureState_t::longPressed:
+        case gestureState_t::doubleTapped:
+        {
+            sendGesture(index, false);
+            _gestureState[index] = gestureState_t::idle;
         }
         break;
 
-        case messageType_t::multiValIncDecNote:
+        case gestureState_t::pressed:
         {
-            uint8_t currentValue = Common::currentValue(index);
-            uint8_t value        = Common::valueIncDec(index, descriptor.dispatchMessage.midiValue);
-
-            if (currentValue != value)
+            if (action.gesture.doubleTapTime)
             {
-                if (!value)
-                    descriptor.dispatchMessage.message = MIDI::messageType_t::noteOff;
-                else
-                    descriptor.dispatchMessage.message = MIDI::messageType_t::noteOn;
-
-                descriptor.dispatchMessage.midiValue = currentValue;
+                _gestureState[index] = gestureState_t::released;
+                _gestureTimers.arm(index, action.gesture.doubleTapTime);
             }
             else
             {
-                send = false;
+                _gestureState[index] = gestureState_t::idle;
             }
         }
         break;
 
-        case messageType_t::multiValIncResetCC:
-        {
-            uint8_t currentValue = Common::currentValue(index);
-            uint8_t value        = Common::valueInc(index, descriptor.dispatchMessage.midiValue, Common::incDecType_t::reset);
-
-            if (currentValue != value)
-                descriptor.dispatchMessage.midiValue = currentValue;
-            else
-                send = false;
-        }
-        break;
-
-        case messageType_t::multiValIncDecCC:
-        {
-            uint8_t currentValue = Common::currentValue(index);
-            uint8_t value        = Common::valueIncDec(index, descriptor.dispatchMessage.midiValue);
-
-            if (currentValue != value)
-                descriptor.dispatchMessage.midiValue = currentValue;
-            else
-                send = false;
-        }
-        break;
-
         default:
         {
-            send = false;
+            _gestureState[index] = gestureState_t::idle;
         }
         break;
         }
     }
-    else
+}
+
+/// Called once the gesture timer of the specified button expires.
+/// param [in]: index   Button index whose timer has expired.
+void Buttons::gestureTimeout(size_t index)
+{
+    const action_t& action = cachedAction(index);
+
+    switch (_gestureState[index])
+    {
+    case gestureState_t::pressed:
     {
-        switch (descriptor.messageType)
+        if (action.gesture.longPressTime)
         {
-        case messageType_t::note:
+            _gestureState[index] = gestureState_t::longPressed;
+            sendGesture(index, true);
+        }
+        else
         {
-            descriptor.dispatchMessage.midiValue = 0;
-            descriptor.dispatchMessage.message   = MIDI::messageType_t::noteOff;
+            //repeat only: resend the regular press message
+            sendMessage(index, true, action);
         }
-        break;
 
-        case messageType_t::controlChangeReset:
+        if (action.gesture.repeatTime)
+            _gestureTimers.arm(index, action.gesture.repeatTime);
+    }
+    break;
+
+    case gestureState_t::longPressed:
+    {
+        if (action.gesture.repeatTime)
         {
-            descriptor.dispatchMessage.midiValue = 0;
+            sendGesture(index, true);
+            _gestureTimers.arm(index, action.gesture.repeatTime);
         }
+    }
+    break;
+
+    case gestureState_t::released:
+    {
+        //second tap hasn't arrived in time
+        _gestureState[index] = gestureState_t::idle;
+    }
+    break;
+
+    default:
         break;
+    }
+}
+
+/// Sends the message of the button using the gesture MIDI ID.
+/// param [in]: index   Button index which sends the gesture.
+/// param [in]: state   True for gesture start, false for gesture end.
+void Buttons::sendGesture(size_t index, bool state)
+{
+    const action_t& action  = cachedAction(index);
+    message_t       message = dispatchMessage(index, action);
+
+    message.midiIndex = action.gesture.midiIndex;
+
+    sendMessage(state, action, message);
+}
+#endif
+
+/// Handles changes in contact states of dual contact button.
+/// Note on is sent once both contacts are closed, with velocity derived from the time between
+/// the closing of the first and the second contact. Note off is sent once the first contact opens.
+/// Latching state of the first contact is used to track whether the note is active.
+/// param [in]: index           Index of the first contact which holds the configuration of the button.
+/// param [in]: contactIndex    Index of the contact which has changed state.
+/// param [in]: reading         New state of the contact.
+/// param [in]: action          Resolved configuration of the button.
+void Buttons::processDualContact(size_t index, size_t contactIndex, bool reading, const action_t& action)
+{
+    //act on change of state only
+    if (reading == state(contactIndex))
+        return;
 
-        case messageType_t::mmcRecord:
+    setState(contactIndex, reading);
+
+    if (reading)
+    {
+        if (latchingState(index) || !state(index) || !state(index + 1))
+            return;
+
+        uint32_t  firstTime  = 0;
+        uint32_t  secondTime = 0;
+        message_t message    = dispatchMessage(index, action);
+
+        //use configured velocity if the contacts aren't timestamped
+        if (_hwa.edgeTime(index, firstTime) && _hwa.edgeTime(index + 1, secondTime))
         {
-            descriptor.dispatchMessage.message = MIDI::messageType_t::mmcRecordStop;
+            //second contact should never close before the first one, treat it as the fastest press
+            int32_t difference = static_cast<int32_t>(secondTime - firstTime);
+
+            message.midiValue = dualContactVelocity(difference > 0 ? difference : 0);
         }
-        break;
 
-        default:
+        setLatchingState(index, true);
+        sendMessage(true, action, message);
+    }
+    else if ((contactIndex == index) && latchingState(index))
+    {
+        setLatchingState(index, false);
+        sendMessage(index, false, action);
+    }
+}
+
+/// Checks whether the specified button is used as second contact of dual contact button.
+/// Dual contact buttons are formed from even button index (first contact) and next odd index (second contact).
+/// param [in]: index    Button index which is being checked.
+/// returns: True if the button is second contact, false otherwise.
+bool Buttons::isSecondContact(size_t index)
+{
+    if (!(index % 2) || (index >= MAX_NUMBER_OF_BUTTONS))
+        return false;
+
+    return cachedAction(index - 1).type == type_t::dualContact;
+}
+
+/// Returns the curve used to convert the time between two contacts into velocity.
+/// Curve is read from the database again only once the database has changed.
+const uint16_t* Buttons::dualContactCurve()
+{
+    if (!_dualContactCurveValid || (_database.revision() != _dualContactCurveRevision))
+    {
+        for (size_t point = 0; point < DUAL_CONTACT_CURVE_POINTS; point++)
+            _dualContactCurve[point] = _database.read(Database::Section::button_t::dualContactCurve, point);
+
+        _dualContactCurveRevision = _database.revision();
+        _dualContactCurveValid    = true;
+    }
+
+    return _dualContactCurve;
+}
+
+/// Converts the time between closing of two contacts of dual contact button into velocity.
+/// Every curve point holds the time for fixed velocity, from the fastest to the slowest press.
+/// Velocity is linearly interpolated between two neighbouring points.
+/// param [in]: time    Time in microseconds between closing of the first and the second contact.
+/// returns: Velocity in 1-127 range.
+uint8_t Buttons::dualContactVelocity(uint32_t time)
+{
+    auto pointVelocity = [](size_t point) {
+        return static_cast<uint32_t>(127 - ((126 * point) / (DUAL_CONTACT_CURVE_POINTS - 1)));
+    };
+
+    const uint16_t* curve = dualContactCurve();
+
+    //curve is stored in 100us units
+    uint32_t previousTime = curve[0] * 100;
+
+    if (time <= previousTime)
+        return pointVelocity(0);
+
+    for (size_t point = 1; point < DUAL_CONTACT_CURVE_POINTS; point++)
+    {
+        uint32_t pointTime = curve[point] * 100;
+
+        if (time < pointTime)
         {
-            send = false;
-        }
-        break;
+            uint32_t velocityRange = pointVelocity(point - 1) - pointVelocity(point);
+
+            return pointVelocity(point - 1) - ((velocityRange * (time - previousTime)) / (pointTime - previousTime));
         }
+
+        //skip the points which would make the curve non-monotonic
+        if (pointTime > previousTime)
+            previousTime = pointTime;
     }
 
-    if (send)
+    return pointVelocity(DUAL_CONTACT_CURVE_POINTS - 1);
+}
+
+/// Used to send MIDI message from specified button.
+/// Used internally once the button state has been changed and processed.
+/// param [in]: index       Button index which sends the message.
+/// param [in]: state       Button state for which the message is sent.
+/// param [in]: action      Resolved configuration of the button.
+void Buttons::sendMessage(size_t index, bool state, const action_t& action)
+{
+    message_t message = dispatchMessage(index, action);
+    sendMessage(state, action, message);
+}
+
+/// Sends the message prepared from button configuration through the handler of the button.
+/// Used when the message needs to differ from the configured one (eg. velocity of dual contact button).
+/// param [in]: state       Button state for which the message is sent.
+/// param [in]: action      Resolved configuration of the button.
+/// param [in]: message     Message to send. Handler can modify it before sending.
+void Buttons::sendMessage(bool state, const action_t& action, message_t& message)
+{
+    if (action.handler == nullptr)
+        return;
+
+    if (action.handler(state, message))
     {
         _dispatcher.notify(Util::MessageDispatcher::messageSource_t::buttons,
-                           descriptor.dispatchMessage,
+                           message,
                            Util::MessageDispatcher::listenType_t::nonFwd);
     }
 }
 
+/// Prepares the message with configured channel, MIDI ID and value of the button.
+Buttons::message_t Buttons::dispatchMessage(size_t index, const action_t& action)
+{
+    message_t message;
+
+    message.componentIndex = index;
+    message.midiChannel    = action.midiChannel;
+    message.midiIndex      = action.midiIndex;
+    message.midiValue      = action.midiValue;
+    message.message        = action.message;
+
+    return message;
+}
+
+/// Note on on press, note off with zero velocity on release.
+bool Buttons::sendNote(bool state, message_t& message)
+{
+    if (!state)
+    {
+        message.midiValue = 0;
+        message.message   = MIDI::messageType_t::noteOff;
+    }
+
+    return true;
+}
+
+/// Configured message on press, nothing on release.
+bool Buttons::sendOnPress(bool state, message_t& message)
+{
+    return state;
+}
+
+/// Configured value on press, zero value on release.
+bool Buttons::sendControlChangeReset(bool state, message_t& message)
+{
+    if (!state)
+        message.midiValue = 0;
+
+    return true;
+}
+
+/// Record start on press, record stop on release.
+bool Buttons::sendMMCRecord(bool state, message_t& message)
+{
+    if (!state)
+        message.message = MIDI::messageType_t::mmcRecordStop;
+
+    return true;
+}
+
+bool Buttons::sendProgramChange(bool state, message_t& message)
+{
+    if (!state)
+        return false;
+
+    message.midiValue = 0;
+    return true;
+}
+
+/// Sends the next program on the configured channel.
+/// Nothing is sent once the last program is reached.
+bool Buttons::sendProgramChangeInc(bool state, message_t& message)
+{
+    if (!state)
+        return false;
+
+    bool send = Common::pcIncrement(message.midiChannel);
+
+    message.midiValue = 0;
+    message.midiIndex = Common::program(message.midiChannel);
+
+    return send;
+}
+
+/// Sends the previous program on the configured channel.
+/// Nothing is sent once the first program is reached.
+bool Buttons::sendProgramChangeDec(bool state, message_t& message)
+{
+    if (!state)
+        return false;
+
+    bool send = Common::pcDecrement(message.midiChannel);
+
+    message.midiValue = 0;
+    message.midiIndex = Common::program(message.midiChannel);
+
+    return send;
+}
+
+/// Increases the value of the button by configured step on every press and resets it once the maximum is reached.
+/// Notes are sent as note off once the value is reset.
+bool Buttons::sendMultiValIncReset(bool state, message_t& message)
+{
+    if (!state)
+        return false;
+
+    uint8_t currentValue = Common::currentValue(message.componentIndex);
+    uint8_t value        = Common::valueInc(message.componentIndex, message.midiValue, Common::incDecType_t::reset);
+
+    if (currentValue == value)
+        return false;
+
+    if (message.message != MIDI::messageType_t::controlChange)
+        message.message = value ? MIDI::messageType_t::noteOn : MIDI::messageType_t::noteOff;
+
+    message.midiValue = currentValue;
+    return true;
+}
+
+/// Increases the value of the button by configured step on every press until the maximum
+/// is reached and then decreases it until the minimum is reached.
+/// Notes are sent as note off once the value reaches the minimum.
+bool Buttons::sendMultiValIncDec(bool state, message_t& message)
+{
+    if (!state)
+        return false;
+
+    uint8_t currentValue = Common::currentValue(message.componentIndex);
+    uint8_t value        = Common::valueIncDec(message.componentIndex, message.midiValue);
+
+    if (currentValue == value)
+        return false;
+
+    if (message.message != MIDI::messageType_t::controlChange)
+        message.message = value ? MIDI::messageType_t::noteOn : MIDI::messageType_t::noteOff;
+
+    message.midiValue = currentValue;
+    return true;
+}
+
 /// Updates current state of button.
 /// param [in]: index       Button for which state is being changed.
 /// param [in]: state       New button state (true/pressed, false/released).
 void Buttons::setState(size_t index, bool state)
 {
-    uint8_t arrayIndex  = index / 8;
+    size_t  arrayIndex  = index / 8;
     uint8_t buttonIndex = index - 8 * arrayIndex;
 
     BIT_WRITE(_buttonPressed[arrayIndex], buttonIndex, state);
@@ -334,7 +622,7 @@ void Buttons::setState(size_t index, bool state)
 /// returns: True if last state was on/pressed, false otherwise.
 bool Buttons::state(size_t index)
 {
-    uint8_t arrayIndex  = index / 8;
+    size_t  arrayIndex  = index / 8;
     uint8_t buttonIndex = index - 8 * arrayIndex;
 
     return BIT_READ(_buttonPressed[arrayIndex], buttonIndex);
@@ -351,7 +639,7 @@ bool Buttons::state(size_t index)
 /// param [in]: state       New latching state.
 void Buttons::setLatchingState(size_t index, bool state)
 {
-    uint8_t arrayIndex  = index / 8;
+    size_t  arrayIndex  = index / 8;
     uint8_t buttonIndex = index - 8 * arrayIndex;
 
     BIT_WRITE(_lastLatchingState[arrayIndex], buttonIndex, state);
@@ -362,7 +650,7 @@ void Buttons::setLatchingState(size_t index, bool state)
 /// returns: True if last state was on/pressed, false otherwise.
 bool Buttons::latchingState(size_t index)
 {
-    uint8_t arrayIndex  = index / 8;
+    size_t  arrayIndex  = index / 8;
     uint8_t buttonIndex = index - 8 * arrayIndex;
 
     return BIT_READ(_lastLatchingState[arrayIndex], buttonIndex);
@@ -374,57 +662,155 @@ void Buttons::reset(size_t index)
 {
     setState(index, false);
     setLatchingState(index, false);
+
+#ifdef BUTTON_GESTURES
+    if (index < GESTURE_BUTTONS)
+    {
+        _gestureTimers.cancel(index);
+        _gestureState[index] = gestureState_t::idle;
+    }
+#endif
 }
 
-void Buttons::fillButtonDescriptor(size_t index, buttonDescriptor_t& descriptor)
+/// Returns the resolved configuration of the specified button.
+/// Configuration is resolved again only once the database has changed.
+/// param [in]: index   Index of the button. Only buttons, and not analog or touchscreen components, are supported.
+const Buttons::action_t& Buttons::cachedAction(size_t index)
 {
-    descriptor.type                           = static_cast<type_t>(_database.read(Database::Section::button_t::type, index));
-    descriptor.messageType                    = static_cast<messageType_t>(_database.read(Database::Section::button_t::midiMessage, index));
-    descriptor.dispatchMessage.componentIndex = index;
-    descriptor.dispatchMessage.midiChannel    = _database.read(Database::Section::button_t::midiChannel, index);
-    descriptor.dispatchMessage.midiIndex      = _database.read(Database::Section::button_t::midiID, index);
-    descriptor.dispatchMessage.midiValue      = _database.read(Database::Section::button_t::velocity, index);
+    if (_database.revision() != _actionRevision)
+    {
+        _actionRevision = _database.revision();
+        _actionValid.fill(0);
+    }
 
-    //overwrite type under certain conditions
-    switch (descriptor.messageType)
+    if (!(_actionValid[index / 32] & (static_cast<uint32_t>(1) << (index % 32))))
     {
-    case messageType_t::programChange:
-    case messageType_t::programChangeInc:
-    case messageType_t::programChangeDec:
+        buildAction(index, _actions[index]);
+        _actionValid[index / 32] |= (static_cast<uint32_t>(1) << (index % 32));
+    }
+
+    return _actions[index];
+}
+
+/// Resolves the configuration of the specified button from the database.
+/// param [in]: index   Index of the button.
+/// param [in]: action  Structure in which the configuration is stored.
+void Buttons::buildAction(size_t index, action_t& action)
+{
+    action.type        = static_cast<type_t>(_database.read(Database::Section::button_t::type, index));
+    action.messageType = static_cast<messageType_t>(_database.read(Database::Section::button_t::midiMessage, index));
+    action.midiChannel = _database.read(Database::Section::button_t::midiChannel, index);
+    action.midiIndex   = _database.read(Database::Section::button_t::midiID, index);
+    action.midiValue   = _database.read(Database::Section::button_t::velocity, index);
+
+    if (index < MAX_NUMBER_OF_BUTTONS)
+    {
+        action.debounce.profile        = static_cast<debounceProfile_t>(_database.read(Database::Section::button_t::debounceProfile, index));
+        action.debounce.pressSamples   = _database.read(Database::Section::button_t::debouncePressSamples, index);
+        action.debounce.releaseSamples = _database.read(Database::Section::button_t::debounceReleaseSamples, index);
+    }
+
+#ifdef BUTTON_GESTURES
+    if (index < GESTURE_BUTTONS)
+    {
+        action.gesture.longPressTime = _database.read(Database::Section::button_t::gestureLongPressTime, index);
+        action.gesture.doubleTapTime = _database.read(Database::Section::button_t::gestureDoubleTapTime, index);
+        action.gesture.repeatTime    = _database.read(Database::Section::button_t::gestureRepeatTime, index);
+        action.gesture.midiIndex     = _database.read(Database::Section::button_t::gestureMidiID, index);
+    }
+#endif
+
+    switch (action.messageType)
+    {
+    case messageType_t::note:
+    {
+        action.handler = sendNote;
+    }
+    break;
+
+    case messageType_t::controlChangeReset:
+    {
+        action.handler = sendControlChangeReset;
+    }
+    break;
+
+    case messageType_t::mmcRecord:
+    {
+        action.type    = type_t::latching;
+        action.handler = sendMMCRecord;
+    }
+    break;
+
+    case messageType_t::controlChange:
     case messageType_t::mmcPlay:
     case messageType_t::mmcStop:
     case messageType_t::mmcPause:
-    case messageType_t::controlChange:
     case messageType_t::realTimeClock:
     case messageType_t::realTimeStart:
     case messageType_t::realTimeContinue:
     case messageType_t::realTimeStop:
     case messageType_t::realTimeActiveSensing:
     case messageType_t::realTimeSystemReset:
+    {
+        action.type    = type_t::momentary;
+        action.handler = sendOnPress;
+    }
+    break;
+
+    case messageType_t::programChange:
+    {
+        action.type    = type_t::momentary;
+        action.handler = sendProgramChange;
+    }
+    break;
+
+    case messageType_t::programChangeInc:
+    {
+        action.type    = type_t::momentary;
+        action.handler = sendProgramChangeInc;
+    }
+    break;
+
+    case messageType_t::programChangeDec:
+    {
+        action.type    = type_t::momentary;
+        action.handler = sendProgramChangeDec;
+    }
+    break;
+
     case messageType_t::multiValIncResetNote:
-    case messageType_t::multiValIncDecNote:
     case messageType_t::multiValIncResetCC:
-    case messageType_t::multiValIncDecCC:
     {
-        descriptor.type = type_t::momentary;
+        action.type    = type_t::momentary;
+        action.handler = sendMultiValIncReset;
     }
     break;
 
-    case messageType_t::mmcRecord:
+    case messageType_t::multiValIncDecNote:
+    case messageType_t::multiValIncDecCC:
     {
-        descriptor.type = type_t::latching;
+        action.type    = type_t::momentary;
+        action.handler = sendMultiValIncDec;
     }
     break;
 
     case messageType_t::presetOpenDeck:
     {
-        descriptor.type = type_t::momentary;
+        action.type    = type_t::momentary;
+        action.handler = nullptr;
     }
     break;
 
     default:
-        break;
+    {
+        action.handler = nullptr;
+    }
+    break;
     }
 
-    descriptor.dispatchMessage.message = _internalMsgToMIDIType[static_cast<uint8_t>(descriptor.messageType)];
-}
\ No newline at end of file
+    //dual contact buttons send notes only and need next button as second contact
+    if ((action.type == type_t::dualContact) && ((action.messageType != messageType_t::note) || (index % 2) || ((index + 1) >= MAX_NUMBER_OF_BUTTONS)))
+        action.type = type_t::momentary;
+
+    action.message = _internalMsgToMIDIType[static_cast<uint8_t>(action.messageType)];
+}
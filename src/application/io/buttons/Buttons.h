@@ -20,6 +20,8 @@ limitations under the License.
 
 #include "database/Database.h"
 #include "util/messaging/Messaging.h"
+#include "io/common/Common.h"
+#include "io/common/TimeWheel.h"
 
 #ifndef BUTTONS_SUPPORTED
 #include "stub/Buttons.h"
@@ -33,9 +35,10 @@ namespace IO
         /// List of all possible button types.
         enum class type_t : uint8_t
         {
-            momentary,    ///< Event on press and release.
-            latching,     ///< Event between presses only.
-            AMOUNT        ///< Total number of button types.
+            momentary,      ///< Event on press and release.
+            latching,       ///< Event between presses only.
+            dualContact,    ///< Note with velocity based on time between first contact (this button) and second contact (next button).
+            AMOUNT          ///< Total number of button types.
         };
 
         /// List of all possible MIDI messages buttons can send.
@@ -66,17 +69,66 @@ namespace IO
             AMOUNT
         };
 
+        /// List of all possible debouncing algorithms. All algorithms except board use the
+        /// history of the last 32 raw readings, so the amount of samples is limited to 32.
+        enum class debounceProfile_t : uint8_t
+        {
+            board,           ///< State debounced on board level for all inputs at once.
+            instantPress,    ///< Press on first pressed reading, release after release samples in released state.
+            integrator,      ///< Press or release after press or release samples in the same state.
+            nOfM,            ///< Press or release once press or release readings out of last (press + release - 1) agree.
+            AMOUNT           ///< Total number of debouncing profiles.
+        };
+
+        /// Debouncing configuration of single button.
+        /// Defaults match the database defaults and the default release time of board debouncing.
+        struct debounce_t
+        {
+            debounceProfile_t profile        = debounceProfile_t::board;
+            uint8_t           pressSamples   = 1;
+            uint8_t           releaseSamples = 5;
+        };
+
+        using changedBitmap_t = Common::bitmap_t<MAX_NUMBER_OF_BUTTONS>;
+
+        /// Amount of points in the curve used to convert the time between two contacts
+        /// of dual contact button into velocity.
+        static constexpr size_t DUAL_CONTACT_CURVE_POINTS = 8;
+
+        /// Default time in 100 us units between two contacts for every curve point.
+        static constexpr uint16_t DUAL_CONTACT_CURVE_DEFAULT[DUAL_CONTACT_CURVE_POINTS] = { 20, 40, 70, 110, 160, 230, 320, 450 };
+
+#ifdef BUTTON_GESTURES
+        /// Amount of buttons which can be configured to send gestures (long press, double tap, hold-repeat).
+        static constexpr size_t GESTURE_BUTTONS = MAX_NUMBER_OF_BUTTONS;
+#else
+        static constexpr size_t GESTURE_BUTTONS = 0;
+#endif
+
+        /// Resolution of gesture times in milliseconds.
+        static constexpr uint32_t GESTURE_TICK_MS = 10;
+
         class HWA
         {
             public:
             //should return true if the value has been refreshed, false otherwise
-            virtual bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) = 0;
+            //states should contain raw reading history with newest reading in LSB bit
+            //debounced should contain the state debounced on board level
+            virtual bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states, bool& debounced) = 0;
+
+            //should set the bits of all buttons which could have changed since the last call
+            //and return true if at least one bit is set, false otherwise
+            virtual bool changed(changedBitmap_t& bitmap) = 0;
+
+            //should return the time in microseconds at which the button has last changed its state
+            //the time should be captured when the button is sampled and not when it's read
+            virtual bool edgeTime(size_t index, uint32_t& time) = 0;
         };
 
         class Filter
         {
             public:
-            virtual bool isFiltered(size_t index, uint8_t& numberOfReadings, uint32_t& states) = 0;
+            virtual bool isFiltered(size_t index, const debounce_t& debounce, bool debounced, uint8_t& numberOfReadings, uint32_t& states) = 0;
         };
 
         Buttons(HWA&                     hwa,
@@ -89,27 +141,106 @@ namespace IO
         void reset(size_t index);
 
         private:
-        struct buttonDescriptor_t
+        using message_t = Util::MessageDispatcher::message_t;
+
+        /// Function which turns the new button state into MIDI message.
+        /// Message is prepared from button configuration before the call and can be modified.
+        /// Should return true if the message should be sent, false otherwise.
+        using handler_t = bool (*)(bool state, message_t& message);
+
+        /// Gesture configuration of single button. Times are stored in GESTURE_TICK_MS units.
+        struct gesture_t
         {
-            type_t                             type        = type_t::momentary;
-            messageType_t                      messageType = messageType_t::note;
-            Util::MessageDispatcher::message_t dispatchMessage;
+            uint8_t longPressTime = 0;
+            uint8_t doubleTapTime = 0;
+            uint8_t repeatTime    = 0;
+            uint8_t midiIndex     = 0;
+        };
 
-            buttonDescriptor_t() = default;
+        /// Configuration of single button resolved from database once, so that the change
+        /// of button state requires no database reads and no checks of message type.
+        struct action_t
+        {
+            handler_t           handler     = nullptr;
+            type_t              type        = type_t::momentary;
+            messageType_t       messageType = messageType_t::note;
+            MIDI::messageType_t message     = MIDI::messageType_t::invalid;
+            uint8_t             midiChannel = 0;
+            uint8_t             midiIndex   = 0;
+            uint8_t             midiValue   = 0;
+            debounce_t          debounce;
+#ifdef BUTTON_GESTURES
+            gesture_t           gesture;
+#endif
         };
 
-        void fillButtonDescriptor(size_t index, buttonDescriptor_t& descriptor);
-        void processButton(size_t index, bool reading, buttonDescriptor_t& descriptor);
-        void sendMessage(size_t index, bool state, buttonDescriptor_t& descriptor);
-        void setState(size_t index, bool state);
-        void setLatchingState(size_t index, bool state);
-        bool latchingState(size_t index);
+        void            buildAction(size_t index, action_t& action);
+        const action_t& cachedAction(size_t index);
+        message_t       dispatchMessage(size_t index, const action_t& action);
+        void            processButton(size_t index, bool reading, const action_t& action);
+        void            processDualContact(size_t index, size_t contactIndex, bool reading, const action_t& action);
+        bool            isSecondContact(size_t index);
+        const uint16_t* dualContactCurve();
+        uint8_t         dualContactVelocity(uint32_t time);
+        void            sendMessage(size_t index, bool state, const action_t& action);
+        void            sendMessage(bool state, const action_t& action, message_t& message);
+        void            setState(size_t index, bool state);
+        void            setLatchingState(size_t index, bool state);
+        bool            latchingState(size_t index);
+
+        static bool sendNote(bool state, message_t& message);
+        static bool sendOnPress(bool state, message_t& message);
+        static bool sendControlChangeReset(bool state, message_t& message);
+        static bool sendMMCRecord(bool state, message_t& message);
+        static bool sendProgramChange(bool state, message_t& message);
+        static bool sendProgramChangeInc(bool state, message_t& message);
+        static bool sendProgramChangeDec(bool state, message_t& message);
+        static bool sendMultiValIncReset(bool state, message_t& message);
+        static bool sendMultiValIncDec(bool state, message_t& message);
+
+#ifdef BUTTON_GESTURES
+        void processGesture(size_t index, bool reading, const action_t& action);
+        void gestureTimeout(size_t index);
+        void sendGesture(size_t index, bool state);
+#endif
 
         HWA&                     _hwa;
         Filter&                  _filter;
         Database&                _database;
         Util::MessageDispatcher& _dispatcher;
 
+        /// Buttons whose filtered state differs from the latest raw reading. These are polled
+        /// even if they haven't changed since the filter could still change their state.
+        changedBitmap_t _debouncePending = {};
+
+        /// Resolved configuration of every button. Analog and touchscreen buttons
+        /// resolve their configuration on every change instead to save RAM.
+        action_t _actions[MAX_NUMBER_OF_BUTTONS];
+
+        /// Buttons whose action holds the configuration matching the database revision below.
+        changedBitmap_t _actionValid    = {};
+        uint32_t        _actionRevision = 0;
+
+        /// Curve used by dual contact buttons, in 100 us units, read from the database
+        /// once per database revision so that note on doesn't wait for database reads.
+        uint16_t _dualContactCurve[DUAL_CONTACT_CURVE_POINTS] = {};
+        bool     _dualContactCurveValid                       = false;
+        uint32_t _dualContactCurveRevision                    = 0;
+
+#ifdef BUTTON_GESTURES
+        enum class gestureState_t : uint8_t
+        {
+            idle,            ///< Button isn't pressed and no gesture is in progress.
+            pressed,         ///< Button is pressed, waiting for long press or repeat time.
+            longPressed,     ///< Long press message has been sent, button is still pressed.
+            released,        ///< Button has been released after short press, waiting for second tap.
+            doubleTapped,    ///< Double tap message has been sent, button is still pressed.
+        };
+
+        gestureState_t                     _gestureState[GESTURE_BUTTONS] = {};
+        Common::TimeWheel<GESTURE_BUTTONS> _gestureTimers;
+#endif
+
         uint8_t _buttonPressed[(MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_COMPONENTS) / 8 + 1]     = {};
         uint8_t _lastLatchingState[(MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_COMPONENTS) / 8 + 1] = {};
 
@@ -31,41 +31,99 @@ namespace IO
         public:
         ButtonsFilter() = default;
 
-        bool isFiltered(size_t index, uint8_t& numberOfReadings, uint32_t& states) override
+        /// Largest amount of samples debouncing algorithms can use.
+        static constexpr uint8_t MAX_SAMPLES = 32;
+
+        bool isFiltered(size_t index, const Buttons::debounce_t& debounce, bool debounced, uint8_t& numberOfReadings, uint32_t& states) override
         {
-            //this is a board-optimized debouncer
-            //by the time processing of buttons takes place, more than 5ms has already passed
-            //5ms is release debounce time
-            //take into account only two latest readings
-            //if any of those is 1 (pressed), consider the button pressed
-            //otherwise, button is considered released
+            if (index >= MAX_NUMBER_OF_BUTTONS)
+                return false;
+
+            bool state = filter(debounce, (_state[index / 32] >> (index % 32)) & 0x01, debounced, states);
+
+            if (state)
+                _state[index / 32] |= (static_cast<uint32_t>(1) << (index % 32));
+            else
+                _state[index / 32] &= ~(static_cast<uint32_t>(1) << (index % 32));
 
+            //only the latest filtered state is relevant
             numberOfReadings = 1;
+            states           = state;
 
-            if (index >= MAX_NUMBER_OF_BUTTONS)
+            return true;
+        }
+
+        /// Runs the debouncing algorithm on the history of raw readings.
+        /// Decision is made on the latest readings only, so the result doesn't depend on
+        /// how often the readings are checked as long as the check is done at least once
+        /// per MAX_SAMPLES readings.
+        /// param [in]: debounce    Debouncing configuration.
+        /// param [in]: state       Current filtered state.
+        /// param [in]: debounced   State debounced on board level.
+        /// param [in]: readings    History of raw readings, newest reading in LSB bit.
+        /// returns: New filtered state.
+        static bool filter(const Buttons::debounce_t& debounce, bool state, bool debounced, uint32_t readings)
+        {
+            const uint8_t press   = constrainSamples(debounce.pressSamples);
+            const uint8_t release = constrainSamples(debounce.releaseSamples);
+
+            switch (debounce.profile)
             {
-                //don't debounce analog inputs and touchscreen buttons
-                states = states & 0x01;
-                return true;
-            }
+            case Buttons::debounceProfile_t::instantPress:
+            {
+                if (!state)
+                    return readings & 0x01;
 
-            states &= 0x03;
+                return readings & mask(release);
+            }
 
-            if (numberOfReadings >= 2)
+            case Buttons::debounceProfile_t::integrator:
             {
-                if (states)
-                {
-                    //button is pressed
-                    states = 0x01;
-                }
+                if (!state)
+                    return (readings & mask(press)) == mask(press);
+
+                return readings & mask(release);
             }
-            else
+
+            case Buttons::debounceProfile_t::nOfM:
             {
-                states &= 0x01;
+                //press and release conditions can't be met at the same time in this window
+                uint8_t window = press + release - 1;
+
+                if (window > MAX_SAMPLES)
+                    window = MAX_SAMPLES;
+
+                const uint8_t pressed = __builtin_popcount(readings & mask(window));
+
+                if (!state)
+                    return pressed >= press;
+
+                return (window - pressed) < release;
             }
 
-            return true;
+            default:
+                return debounced;
+            }
+        }
+
+        private:
+        static uint8_t constrainSamples(uint8_t samples)
+        {
+            if (!samples)
+                return 1;
+
+            if (samples > MAX_SAMPLES)
+                return MAX_SAMPLES;
+
+            return samples;
         }
+
+        static uint32_t mask(uint8_t samples)
+        {
+            return samples >= MAX_SAMPLES ? 0xFFFFFFFF : ((static_cast<uint32_t>(1) << samples) - 1);
+        }
+
+        uint32_t _state[(MAX_NUMBER_OF_BUTTONS + 31) / 32 ? (MAX_NUMBER_OF_BUTTONS + 31) / 32 : 1] = {};
     };
 }    // namespace IO
 
@@ -18,6 +18,8 @@ limitations under the License.
 
 #pragma once
 
+#include "io/common/Common.h"
+
 namespace IO
 {
     class Buttons
@@ -25,9 +27,10 @@ namespace IO
         public:
         enum class type_t : uint8_t
         {
-            momentary,    ///< Event on press and release.
-            latching,     ///< Event between presses only.
-            AMOUNT        ///< Total number of button types.
+            momentary,      ///< Event on press and release.
+            latching,       ///< Event between presses only.
+            dualContact,    ///< Note with velocity based on time between first contact (this button) and second contact (next button).
+            AMOUNT          ///< Total number of button types.
         };
 
         enum class messageType_t : uint8_t
@@ -57,16 +60,41 @@ namespace IO
             AMOUNT
         };
 
+        enum class debounceProfile_t : uint8_t
+        {
+            board,
+            instantPress,
+            integrator,
+            nOfM,
+            AMOUNT
+        };
+
+        struct debounce_t
+        {
+            debounceProfile_t profile        = debounceProfile_t::board;
+            uint8_t           pressSamples   = 1;
+            uint8_t           releaseSamples = 5;
+        };
+
+        using changedBitmap_t = Common::bitmap_t<MAX_NUMBER_OF_BUTTONS>;
+
+        static constexpr size_t   DUAL_CONTACT_CURVE_POINTS                             = 8;
+        static constexpr uint16_t DUAL_CONTACT_CURVE_DEFAULT[DUAL_CONTACT_CURVE_POINTS] = { 20, 40, 70, 110, 160, 230, 320, 450 };
+        static constexpr size_t   GESTURE_BUTTONS                                       = 0;
+        static constexpr uint32_t GESTURE_TICK_MS                                       = 10;
+
         class HWA
         {
             public:
-            virtual bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) = 0;
+            virtual bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states, bool& debounced) = 0;
+            virtual bool changed(changedBitmap_t& bitmap)                                                  = 0;
+            virtual bool edgeTime(size_t index, uint32_t& time)                                            = 0;
         };
 
         class Filter
         {
             public:
-            virtual bool isFiltered(size_t index, uint8_t& numberOfReadings, uint32_t& states) = 0;
+            virtual bool isFiltered(size_t index, const debounce_t& debounce, bool debounced, uint8_t& numberOfReadings, uint32_t& states) = 0;
         };
 
         Buttons(HWA&                     hwa,
@@ -27,7 +27,7 @@ namespace IO
         public:
         ButtonsFilter() {}
 
-        bool isFiltered(size_t index, uint8_t& numberOfReadings, uint32_t& states) override
+        bool isFiltered(size_t index, const IO::Buttons::debounce_t& debounce, bool debounced, uint8_t& numberOfReadings, uint32_t& states) override
         {
             return false;
         }
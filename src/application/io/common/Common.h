@@ -20,6 +20,8 @@ limitations under the License.
 
 #include <inttypes.h>
 #include <stddef.h>
+#include <array>
+#include <type_traits>
 
 namespace IO
 {
@@ -39,5 +41,103 @@ namespace IO
         uint8_t valueIncDec(size_t index, uint8_t step);
         uint8_t currentValue(size_t index);
         void    resetValue(size_t index);
+
+        /// Bitmap holding single bit for every component.
+        template<size_t size>
+        using bitmap_t = std::array<uint32_t, (size + 31) / 32 ? (size + 31) / 32 : 1>;
+
+        /// Calls provided function for every set bit in bitmap, starting from the lowest index.
+        /// Only set bits are visited so the cost depends on amount of set bits and not on bitmap size.
+        /// param [in]: bitmap      Bitmap to iterate.
+        /// param [in]: callback    Function called with the index of every set bit.
+        template<size_t size, typename T>
+        void forEachSetBit(const std::array<uint32_t, size>& bitmap, T&& callback)
+        {
+            for (size_t word = 0; word < size; word++)
+            {
+                uint32_t bits = bitmap[word];
+
+                while (bits)
+                {
+                    callback((word * 32) + __builtin_ctz(bits));
+
+                    //clear lowest set bit
+                    bits &= bits - 1;
+                }
+            }
+        }
+
+        /// Groups components by key (eg. MIDI ID) so that only the components assigned to specific
+        /// key are visited when searching for components which should react to incoming message.
+        /// Components with the same key are chained in a list, so the cost of lookup depends on amount
+        /// of components sharing the key and not on total amount of components.
+        /// With linearLimit or less components no table is kept and every component is visited:
+        /// linear search is fast enough at that size and RAM is saved on small targets.
+        /// Callback needs to check whether the visited component really matches in both cases.
+        template<size_t components, size_t keys, size_t linearLimit = 64>
+        class ComponentIndex
+        {
+            public:
+            static constexpr bool INDEXED = components > linearLimit;
+
+            ComponentIndex()
+            {
+                clear();
+            }
+
+            /// Removes all components from the table.
+            void clear()
+            {
+                if constexpr (INDEXED)
+                {
+                    for (size_t i = 0; i < keys; i++)
+                        _head[i] = NONE;
+                }
+            }
+
+            /// Assigns component to the given key.
+            /// Every component should be assigned only once after clear.
+            void assign(size_t component, size_t key)
+            {
+                if constexpr (INDEXED)
+                {
+                    if ((component >= components) || (key >= keys))
+                        return;
+
+                    _next[component] = _head[key];
+                    _head[key]       = component;
+                }
+            }
+
+            /// Calls provided function for every component assigned to the given key.
+            /// Order in which the components are visited isn't defined.
+            template<typename T>
+            void forEach(size_t key, T&& callback) const
+            {
+                if constexpr (INDEXED)
+                {
+                    if (key >= keys)
+                        return;
+
+                    for (index_t i = _head[key]; i != NONE; i = _next[i])
+                        callback(i);
+                }
+                else
+                {
+                    for (size_t i = 0; i < components; i++)
+                        callback(i);
+                }
+            }
+
+            private:
+            using index_t = typename std::conditional<(components < 0xFF), uint8_t, uint16_t>::type;
+
+            static constexpr index_t NONE  = static_cast<index_t>(~0);
+            static constexpr size_t  HEADS = INDEXED ? keys : 1;
+            static constexpr size_t  NODES = INDEXED ? components : 1;
+
+            index_t _head[HEADS] = {};
+            index_t _next[NODES] = {};
+        };
     }    // namespace Common
 }    // namespace IO
\ No newline at end of file
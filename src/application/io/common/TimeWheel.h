@@ -0,0 +1,167 @@
+/*
+
+Copyright 2015-2021 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <type_traits>
+
+namespace IO
+{
+    namespace Common
+    {
+        /// Hashed time wheel holding one timer per component.
+        /// Armed timers are chained in the slot selected by their deadline, so advancing the
+        /// wheel by one tick visits only the timers in a single slot. Timers which expire more
+        /// than one revolution away stay in their slot until the deadline is reached.
+        /// Cost of advancing the wheel depends on amount of armed timers and not on amount of components.
+        template<size_t timers, size_t slots = 32>
+        class TimeWheel
+        {
+            static_assert(slots && !(slots & (slots - 1)), "Amount of slots must be power of two");
+
+            public:
+            TimeWheel()
+            {
+                for (size_t i = 0; i < slots; i++)
+                    _head[i] = NONE;
+
+                for (size_t i = 0; i < timers; i++)
+                {
+                    _next[i] = NONE;
+                    _prev[i] = NONE;
+                }
+            }
+
+            /// Starts the timer. Timer which is already running is restarted.
+            /// param [in]: timer   Index of timer to start.
+            /// param [in]: ticks   Amount of ticks from now after which the timer expires.
+            void arm(size_t timer, uint16_t ticks)
+            {
+                if (timer >= timers)
+                    return;
+
+                cancel(timer);
+
+                if (!ticks)
+                    ticks = 1;
+
+                _deadline[timer] = _tick + ticks;
+                link(timer);
+                _count++;
+            }
+
+            /// Stops the timer. Nothing is done if the timer isn't running.
+            void cancel(size_t timer)
+            {
+                if ((timer >= timers) || !isArmed(timer))
+                    return;
+
+                unlink(timer);
+                _count--;
+            }
+
+            bool isArmed(size_t timer) const
+            {
+                return (_armed[timer / 8] >> (timer % 8)) & 0x01;
+            }
+
+            /// Moves the wheel forward up to the given tick.
+            /// param [in]: now         Current tick.
+            /// param [in]: callback    Function called with the index of every expired timer.
+            ///                         Callback can restart the expired timer, but shouldn't
+            ///                         change any other timer.
+            template<typename T>
+            void advance(uint16_t now, T&& callback)
+            {
+                //nothing can expire, skip the elapsed ticks at once
+                if (!_count)
+                {
+                    _tick = now;
+                    return;
+                }
+
+                while ((_tick != now) && _count)
+                {
+                    _tick++;
+
+                    index_t timer = _head[_tick & (slots - 1)];
+
+                    while (timer != NONE)
+                    {
+                        index_t next = _next[timer];
+
+                        if (_deadline[timer] == _tick)
+                        {
+                            unlink(timer);
+                            _count--;
+                            callback(timer);
+                        }
+
+                        timer = next;
+                    }
+                }
+
+                _tick = now;
+            }
+
+            private:
+            using index_t = typename std::conditional<(timers < 0xFF), uint8_t, uint16_t>::type;
+
+            static constexpr index_t NONE = static_cast<index_t>(~0);
+
+            void link(size_t timer)
+            {
+                const size_t slot = _deadline[timer] & (slots - 1);
+
+                _prev[timer] = NONE;
+                _next[timer] = _head[slot];
+
+                if (_head[slot] != NONE)
+                    _prev[_head[slot]] = timer;
+
+                _head[slot] = timer;
+                _armed[timer / 8] |= (1 << (timer % 8));
+            }
+
+            void unlink(size_t timer)
+            {
+                if (_prev[timer] != NONE)
+                    _next[_prev[timer]] = _next[timer];
+                else
+                    _head[_deadline[timer] & (slots - 1)] = _next[timer];
+
+                if (_next[timer] != NONE)
+                    _prev[_next[timer]] = _prev[timer];
+
+                _next[timer] = NONE;
+                _prev[timer] = NONE;
+                _armed[timer / 8] &= ~(1 << (timer % 8));
+            }
+
+            uint16_t _tick                    = 0;
+            size_t   _count                   = 0;
+            index_t  _head[slots]             = {};
+            index_t  _next[timers]            = {};
+            index_t  _prev[timers]            = {};
+            uint16_t _deadline[timers]        = {};
+            uint8_t  _armed[(timers / 8) + 1] = {};
+        };
+    }    // namespace Common
+}    // namespace IO
@@ -25,17 +25,16 @@ using namespace IO;
 
 Encoders::Encoders(HWA&                     hwa,
                    Filter&                  filter,
-                   uint32_t                 timeDiffTimeout,
                    Database&                database,
                    Util::MessageDispatcher& dispatcher)
     : _hwa(hwa)
     , _filter(filter)
-    , TIME_DIFF_READOUT(timeDiffTimeout)
     , _database(database)
     , _dispatcher(dispatcher)
 {
+    //values are read from database once it's accessed for the first time
     for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
-        resetValue(i);
+        resetState(i);
 
     _dispatcher.listen(Util::MessageDispatcher::messageSource_t::midiIn,
                        Util::MessageDispatcher::listenType_t::nonFwd,
@@ -44,22 +43,15 @@ Encoders::Encoders(HWA&                     hwa,
                            {
                            case MIDI::messageType_t::controlChange:
                            {
-                               for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
-                               {
-                                   if (!_database.read(Database::Section::encoder_t::remoteSync, i))
-                                       continue;
+                               if (!_remoteSyncValid || (_remoteSyncRevision != _database.revision()))
+                                   buildRemoteSyncLookup();
 
-                                   if (_database.read(Database::Section::encoder_t::mode, i) != static_cast<int32_t>(IO::Encoders::type_t::controlChange))
-                                       continue;
+                               const uint16_t key = remoteSyncKey(dispatchMessage.midiChannel, dispatchMessage.midiIndex);
 
-                                   if (_database.read(Database::Section::encoder_t::midiChannel, i) != dispatchMessage.midiChannel)
-                                       continue;
-
-                                   if (_database.read(Database::Section::encoder_t::midiID, i) != dispatchMessage.midiIndex)
-                                       continue;
-
-                                   setValue(i, dispatchMessage.midiValue);
-                               }
+                               _remoteSyncLookup.forEach(dispatchMessage.midiIndex, [&](size_t i) {
+                                   if (_remoteSyncKey[i] == key)
+                                       setValue(i, dispatchMessage.midiValue);
+                               });
                            }
                            break;
 
@@ -72,151 +64,311 @@ Encoders::Encoders(HWA&                     hwa,
 /// Continuously checks state of all encoders.
 void Encoders::update()
 {
-    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    if (!_enabledValid || (_enabledRevision != _database.revision()))
     {
-        if (!_database.read(Database::Section::encoder_t::enable, i))
-            continue;
+        buildEnableBitmap();
+        selectValuePreset();
+    }
 
-        uint8_t  numberOfReadings = 0;
-        uint32_t states           = 0;
+    //pulses decoded by board have been made since the previous update
+    const uint32_t currentTime = core::timing::currentRunTimeMs();
+    const uint32_t elapsed     = currentTime - _lastUpdateTime;
 
-        if (!_hwa.state(i, numberOfReadings, states))
-            continue;
+    _lastUpdateTime = currentTime;
+
+    storeValues(currentTime);
+
+    changedBitmap_t changed;
+
+    //visit only the encoders which could have moved
+    if (!_hwa.changed(changed))
+        return;
+
+    changedBitmap_t disabled;
+
+    for (size_t i = 0; i < changed.size(); i++)
+    {
+        disabled[i] = changed[i] & ~_enabled[i];
+        changed[i] &= _enabled[i];
+    }
+
+    //drop the pulses so that they aren't applied once the encoder is enabled
+    Common::forEachSetBit(disabled, [this](size_t i) {
+        if (i >= MAX_NUMBER_OF_ENCODERS)
+            return;
+
+        int16_t pulses = 0;
+        _hwa.pulses(i, pulses);
+    });
+
+    Common::forEachSetBit(changed, [&](size_t i) {
+        int16_t pulses = 0;
+
+        if (!_hwa.pulses(i, pulses) || !pulses)
+            return;
+
+        encoderDescriptor_t descriptor;
+        movement_t          movement;
+
+        fillEncoderDescriptor(i, descriptor);
+        processPulses(i, descriptor, pulses, currentTime, elapsed, movement);
+
+        //all the steps made since the last update are sent in single message
+        sendMovement(i, descriptor, movement);
+    });
+}
+
+/// Converts the pulses decoded by board into encoder steps.
+/// param [in]: index       Encoder which is being processed.
+/// param [in]: descriptor  Configuration of the encoder.
+/// param [in]: pulses      Amount of pulses decoded since the last call, positive on clockwise movement.
+/// param [in]: sampleTime  Time at which the pulses have been read.
+/// param [in]: elapsed     Time in milliseconds during which the pulses have been made.
+/// param [in,out]: movement    Movement to which the steps are added.
+void Encoders::processPulses(size_t index, const encoderDescriptor_t& descriptor, int16_t pulses, uint32_t sampleTime, uint32_t elapsed, movement_t& movement)
+{
+    const int32_t pulsesPerStep = descriptor.pulsesPerStep ? descriptor.pulsesPerStep : 1;
+    int32_t       total         = _encoderPulses[index] + pulses;
+    const int32_t steps         = abs(total) / pulsesPerStep;
 
-        uint32_t currentTime = core::timing::currentRunTimeMs();
+    //board doesn't provide the time of each pulse, so the steps are spread evenly over
+    //the elapsed time to keep the speed used for acceleration independent of read rate
+    //intervals longer than 255 ms are all treated as slow movement
+    const uint32_t interval = steps ? ((elapsed / steps) > 255 ? 255 : (elapsed / steps)) : 0;
 
-        for (uint8_t reading = 0; reading < numberOfReadings; reading++)
+    //fast movement can produce several steps between two reads
+    for (int32_t step = 0; step < steps; step++)
+    {
+        const uint32_t stepTime = sampleTime - (interval * (steps - 1 - step));
+
+        if (total > 0)
+        {
+            total -= pulsesPerStep;
+            processPosition(index, descriptor, position_t::cw, stepTime, movement);
+        }
+        else
         {
-            //take into account that there is a 1ms difference between readouts
-            //when processing, newest sample has index 0
-            //start from oldest reading which is in upper bits
-            uint8_t  processIndex = numberOfReadings - 1 - reading;
-            uint32_t sampleTime   = currentTime - (TIME_DIFF_READOUT * processIndex);
-
-            //there are two readings per encoder
-            uint8_t pairState = states >> (processIndex * 2);
-            pairState &= 0x03;
-
-            //when processing, newest sample has index 0
-            processReading(i, pairState, sampleTime);
+            total += pulsesPerStep;
+            processPosition(index, descriptor, position_t::ccw, stepTime, movement);
         }
     }
+
+    _encoderPulses[index] = total;
+}
+
+/// Runs single step through filter and adds it to the movement made during current update.
+void Encoders::processPosition(size_t index, const encoderDescriptor_t& descriptor, position_t encoderState, uint32_t sampleTime, movement_t& movement)
+{
+    if (!_filter.isFiltered(index, encoderState, encoderState, sampleTime))
+        return;
+
+    if (encoderState == position_t::stopped)
+        return;
+
+    if (descriptor.invert)
+    {
+        if (encoderState == position_t::ccw)
+            encoderState = position_t::cw;
+        else
+            encoderState = position_t::ccw;
+    }
+
+    const uint32_t speed  = registerStep(index, sampleTime);
+    const uint16_t change = descriptor.acceleration ? acceleratedChange(descriptor, speed) : 1;
+
+    if (encoderState == position_t::cw)
+    {
+        movement.steps++;
+        movement.delta += change;
+    }
+    else
+    {
+        movement.steps--;
+        movement.delta -= change;
+    }
+}
+
+/// Stores the time of encoder step and calculates the current speed of encoder.
+/// param [in]: index       Encoder which has made the step.
+/// param [in]: sampleTime  Time at which the step has been made.
+/// returns: Average speed in steps per second over the last SPEED_WINDOW steps.
+uint32_t Encoders::registerStep(size_t index, uint32_t sampleTime)
+{
+    uint16_t interval = static_cast<uint16_t>(sampleTime) - _lastStepTime[index];
+    uint32_t total    = 0;
+
+    _lastStepTime[index] = sampleTime;
+
+    for (size_t i = 0; i < SPEED_WINDOW - 1; i++)
+    {
+        _stepInterval[index][i] = _stepInterval[index][i + 1];
+        total += _stepInterval[index][i];
+    }
+
+    _stepInterval[index][SPEED_WINDOW - 1] = interval > 255 ? 255 : interval;
+    total += _stepInterval[index][SPEED_WINDOW - 1];
+
+    //several steps can be registered at the same time after fast movement
+    if (!total)
+        total = 1;
+
+    return (SPEED_WINDOW * 1000) / total;
 }
 
-void Encoders::processReading(size_t index, uint8_t pairValue, uint32_t sampleTime)
+/// Converts the speed of encoder into the value change for single step using
+/// acceleration curve selected for the encoder.
+/// Curve holds the change for 7-bit modes. 14-bit modes use the square of that change:
+/// slow movement still changes the value by one while the change of 128 (entire 7-bit range)
+/// covers the entire 14-bit range.
+/// param [in]: descriptor  Configuration of the encoder.
+/// param [in]: speed       Current speed of encoder in steps per second.
+/// returns: Value change for single step.
+uint16_t Encoders::acceleratedChange(const encoderDescriptor_t& descriptor, uint32_t speed)
 {
-    position_t encoderState = read(index, pairValue);
+    const size_t curveStart = (descriptor.acceleration - 1) * ACCELERATION_CURVE_POINTS;
+
+    auto pointChange = [&](size_t point) {
+        int32_t change = _database.read(Database::Section::encoder_t::accelerationCurve, curveStart + point);
+        return change < 1 ? 1 : change;
+    };
+
+    //change in 1/256 units so that the interpolation stays precise for 14-bit modes
+    uint32_t change = 256;
 
-    if (_filter.isFiltered(index, encoderState, encoderState, sampleTime))
+    if (speed >= ACCELERATION_CURVE_SPEED[ACCELERATION_CURVE_POINTS - 1])
     {
-        if (encoderState != position_t::stopped)
+        change = pointChange(ACCELERATION_CURVE_POINTS - 1) * 256;
+    }
+    else if (speed > ACCELERATION_CURVE_SPEED[0])
+    {
+        for (size_t point = 1; point < ACCELERATION_CURVE_POINTS; point++)
         {
-            if (_database.read(Database::Section::encoder_t::invert, index))
+            if (speed < ACCELERATION_CURVE_SPEED[point])
             {
-                if (encoderState == position_t::ccw)
-                    encoderState = position_t::cw;
-                else
-                    encoderState = position_t::ccw;
+                const int32_t previous = pointChange(point - 1) * 256;
+                const int32_t next     = pointChange(point) * 256;
+
+                change = previous + ((next - previous) * static_cast<int32_t>(speed - ACCELERATION_CURVE_SPEED[point - 1])) / (ACCELERATION_CURVE_SPEED[point] - ACCELERATION_CURVE_SPEED[point - 1]);
+                break;
             }
+        }
+    }
 
-            uint8_t encAcceleration = _database.read(Database::Section::encoder_t::acceleration, index);
+    if (use14bit(descriptor.type))
+    {
+        change = (change * change + 32768) / 65536;
+        return change > 16383 ? 16383 : change;
+    }
 
-            if (encAcceleration)
-            {
-                //when time difference between two movements is smaller than ENCODERS_SPEED_TIMEOUT,
-                //start accelerating
-                if ((sampleTime - _filter.lastMovementTime(index)) < ENCODERS_SPEED_TIMEOUT)
-                    _encoderSpeed[index] = CONSTRAIN(_encoderSpeed[index] + _encoderSpeedChange[encAcceleration], 0, _encoderMaxAccSpeed[encAcceleration]);
-                else
-                    _encoderSpeed[index] = 0;
-            }
+    return (change + 128) / 256;
+}
 
-            encoderDescriptor_t descriptor;
-            fillEncoderDescriptor(index, descriptor);
+/// Sends single message for all the steps made by encoder during current update.
+/// Absolute modes send the final value and relative modes send the summed change.
+/// 7-bit relative modes are limited to 63 steps in single message.
+void Encoders::sendMovement(size_t index, encoderDescriptor_t& descriptor, const movement_t& movement)
+{
+    if (!movement.steps && !movement.delta)
+        return;
 
-            bool    send  = true;
-            uint8_t steps = (_encoderSpeed[index] > 0) ? _encoderSpeed[index] : 1;
+    bool send = true;
 
-            switch (descriptor.type)
-            {
-            case type_t::controlChange7Fh01h:
-            case type_t::controlChange3Fh41h:
-            {
-                descriptor.dispatchMessage.midiValue = _encValue[static_cast<uint8_t>(descriptor.type)][static_cast<uint8_t>(encoderState)];
-            }
-            break;
+    //relative value can hold up to 63 steps in each direction
+    const uint8_t steps = abs(movement.steps) > 63 ? 63 : abs(movement.steps);
 
-            case type_t::programChange:
-            {
-                if (encoderState == position_t::ccw)
-                {
-                    if (!Common::pcIncrement(descriptor.dispatchMessage.midiChannel))
-                        send = false;    //edge value reached, nothing more to send
-                }
-                else
-                {
-                    if (!Common::pcDecrement(descriptor.dispatchMessage.midiChannel))
-                        send = false;    //edge value reached, nothing more to send
-                }
-
-                descriptor.dispatchMessage.midiValue = Common::program(descriptor.dispatchMessage.midiChannel);
-            }
-            break;
+    switch (descriptor.type)
+    {
+    case type_t::controlChange7Fh01h:
+    {
+        send                                 = steps != 0;
+        descriptor.dispatchMessage.midiValue = (movement.steps > 0) ? steps : 128 - steps;
+    }
+    break;
 
-            case type_t::controlChange:
-            case type_t::pitchBend:
-            case type_t::nrpn7bit:
-            case type_t::nrpn14bit:
-            case type_t::controlChange14bit:
-            {
-                const bool use14bit =
-                    ((descriptor.type == type_t::pitchBend) || (descriptor.type == type_t::nrpn14bit) || (descriptor.type == type_t::controlChange14bit));
+    case type_t::controlChange3Fh41h:
+    {
+        send                                 = steps != 0;
+        descriptor.dispatchMessage.midiValue = (movement.steps > 0) ? 64 + steps : 64 - steps;
+    }
+    break;
 
-                if (use14bit && (steps > 1))
-                    steps <<= 2;
+    case type_t::controlChange41h01h:
+    {
+        //sign and magnitude: bit 6 is set when moving counter-clockwise
+        send                                 = steps != 0;
+        descriptor.dispatchMessage.midiValue = (movement.steps > 0) ? steps : 0x40 | steps;
+    }
+    break;
 
-                if (encoderState == position_t::ccw)
-                {
-                    _midiValue[index] -= steps;
+    case type_t::nrpn14bitRelative:
+    {
+        //14-bit two's complement value holds up to 8191 pulses in each direction
+        const int32_t pulses = CONSTRAIN(static_cast<int32_t>(movement.steps), -8191, 8191);
+
+        send                                 = pulses != 0;
+        descriptor.dispatchMessage.midiValue = pulses & 0x3FFF;
+    }
+    break;
 
-                    if (_midiValue[index] < 0)
-                        _midiValue[index] = 0;
-                }
-                else
-                {
-                    int16_t limit = use14bit ? 16383 : 127;
+    case type_t::programChange:
+    {
+        send = false;
 
-                    _midiValue[index] += steps;
+        for (uint8_t step = 0; step < steps; step++)
+        {
+            bool changed = (movement.steps < 0) ? Common::pcIncrement(descriptor.dispatchMessage.midiChannel)
+                                                : Common::pcDecrement(descriptor.dispatchMessage.midiChannel);
 
-                    if (_midiValue[index] > limit)
-                        _midiValue[index] = limit;
-                }
+            //edge value reached, no further change is possible
+            if (!changed)
+                break;
 
-                descriptor.dispatchMessage.midiValue = _midiValue[index];
-            }
-            break;
+            send = true;
+        }
 
-            case type_t::presetChange:
-            {
-                send           = false;
-                uint8_t preset = _database.getPreset();
-                preset += (encoderState == position_t::cw) ? 1 : -1;
+        descriptor.dispatchMessage.midiValue = Common::program(descriptor.dispatchMessage.midiChannel);
+    }
+    break;
 
-                _database.setPreset(preset);
-            }
-            break;
+    case type_t::controlChange:
+    case type_t::pitchBend:
+    case type_t::nrpn7bit:
+    case type_t::nrpn14bit:
+    case type_t::controlChange14bit:
+    {
+        const int32_t limit = use14bit(descriptor.type) ? 16383 : 127;
 
-            default:
-            {
-                send = false;
-            }
-            break;
-            }
+        const int16_t value = CONSTRAIN(static_cast<int32_t>(_midiValue[_valuePreset][index]) + movement.delta, 0, limit);
 
-            if (send)
-                sendMessage(index, descriptor);
+        if (value != _midiValue[_valuePreset][index])
+        {
+            _midiValue[_valuePreset][index] = value;
+            valueChanged(index);
         }
+
+        descriptor.dispatchMessage.midiValue = value;
+    }
+    break;
+
+    case type_t::presetChange:
+    {
+        send           = false;
+        uint8_t preset = _database.getPreset();
+        preset += movement.steps;
+
+        _database.setPreset(preset);
+    }
+    break;
+
+    default:
+    {
+        send = false;
+    }
+    break;
     }
+
+    if (send)
+        sendMessage(index, descriptor);
 }
 
 void Encoders::sendMessage(size_t index, encoderDescriptor_t& descriptor)
@@ -227,11 +379,13 @@ void Encoders::sendMessage(size_t index, encoderDescriptor_t& descriptor)
     {
     case type_t::controlChange7Fh01h:
     case type_t::controlChange3Fh41h:
+    case type_t::controlChange41h01h:
     case type_t::programChange:
     case type_t::controlChange:
     case type_t::pitchBend:
     case type_t::nrpn7bit:
     case type_t::nrpn14bit:
+    case type_t::nrpn14bitRelative:
         break;
 
     case type_t::controlChange14bit:
@@ -263,62 +417,171 @@ void Encoders::sendMessage(size_t index, encoderDescriptor_t& descriptor)
 /// Sets the MIDI value of specified encoder to default.
 void Encoders::resetValue(size_t index)
 {
-    if (_database.read(Database::Section::encoder_t::mode, index) == static_cast<int32_t>(type_t::pitchBend))
-        _midiValue[index] = 8192;
-    else
-        _midiValue[index] = 0;
+    selectValuePreset();
+
+    _midiValue[_valuePreset][index] = defaultValue(index);
+    valueChanged(index);
+
+    resetState(index);
+}
 
+/// Clears the readings and movement history of specified encoder.
+void Encoders::resetState(size_t index)
+{
     _filter.reset(index);
-    _encoderSpeed[index]  = 0;
-    _encoderData[index]   = 0;
+
+    for (size_t i = 0; i < SPEED_WINDOW; i++)
+        _stepInterval[index][i] = 255;
+
     _encoderPulses[index] = 0;
 }
 
 void Encoders::setValue(size_t index, uint16_t value)
 {
-    _midiValue[index] = value;
+    selectValuePreset();
+
+    _midiValue[_valuePreset][index] = value;
+    valueChanged(index);
 }
 
-/// Checks state of requested encoder.
-/// param [in]: index           Encoder which is being checked.
-/// param [in]: pairState       A and B signal readings from encoder placed into bits 0 and 1.
-/// returns: Encoder direction. See position_t.
-Encoders::position_t Encoders::read(size_t index, uint8_t pairState)
+int16_t Encoders::defaultValue(size_t index)
 {
-    position_t returnValue = position_t::stopped;
-    pairState &= 0x03;
+    if (_database.read(Database::Section::encoder_t::mode, index) == static_cast<int32_t>(type_t::pitchBend))
+        return 8192;
+
+    return 0;
+}
 
-    //add new data
+/// Marks the value of specified encoder in active preset for writing to database.
+void Encoders::valueChanged(size_t index)
+{
+    _valueChanged[_valuePreset][index / 32] |= static_cast<uint32_t>(1) << (index % 32);
+    _lastValueChangeTime = core::timing::currentRunTimeMs();
+}
 
-    bool process = true;
+/// Switches to the values of active preset.
+/// Values are read from database only when the preset is selected for the first
+/// time, afterwards they are kept in RAM until the values in database are overwritten.
+void Encoders::selectValuePreset()
+{
+    const uint8_t preset = _database.getPreset();
 
-    //only process the data from encoder if there is a previous reading stored
-    if (!BIT_READ(_encoderData[index], 7))
-        process = false;
+    if (preset >= Database::MAX_PRESETS)
+        return;
 
-    _encoderData[index] <<= 2;
-    _encoderData[index] |= pairState;
-    _encoderData[index] |= 0x80;
+    if (_valueStateRevision != _database.stateRevision())
+    {
+        //values in database have been replaced (factory reset, preset load), RAM copy isn't valid anymore
+        _valueStateRevision = _database.stateRevision();
+        _valuePresetLoaded  = 0;
+    }
 
-    if (!process)
-        return returnValue;
+    const uint16_t presetMask = static_cast<uint16_t>(1) << preset;
 
-    _encoderPulses[index] += _encoderLookUpTable[_encoderData[index] & 0x0F];
+    _valuePreset = preset;
 
-    if (abs(_encoderPulses[index]) >= _database.read(Database::Section::encoder_t::pulsesPerStep, index))
+    if (_valuePresetLoaded & presetMask)
+        return;
+
+    _valuePresetLoaded |= presetMask;
+
+    //values read from database replace anything set before
+    _valueChanged[preset] = {};
+
+    for (size_t i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
     {
-        returnValue = (_encoderPulses[index] > 0) ? position_t::ccw : position_t::cw;
-        //reset count
-        _encoderPulses[index] = 0;
+        if (_database.read(Database::Section::encoder_t::valueStored, i))
+            _midiValue[preset][i] = _database.read(Database::Section::encoder_t::value, i);
+        else
+            _midiValue[preset][i] = defaultValue(i);
     }
+}
+
+/// Writes the changed values of active preset to database once no value
+/// has been changed for VALUE_STORE_DELAY milliseconds.
+void Encoders::storeValues(uint32_t currentTime)
+{
+    if ((currentTime - _lastValueChangeTime) < VALUE_STORE_DELAY)
+        return;
 
-    return returnValue;
+    storeValues();
+}
+
+/// Immediately writes the changed values of active preset to database.
+/// Must be called before the preset is changed so that no value is left only in RAM.
+void Encoders::storeValues()
+{
+    //values in RAM belong to other preset if the layout has been switched without update in between
+    if (_valuePreset != _database.getPreset())
+        return;
+
+    auto& changed = _valueChanged[_valuePreset];
+
+    Common::forEachSetBit(changed, [&](size_t i) {
+        if (i >= MAX_NUMBER_OF_ENCODERS)
+            return;
+
+        //values are runtime state: writing them mustn't invalidate cached configuration
+        if (!_database.updateState(Database::Section::encoder_t::value, i, _midiValue[_valuePreset][i]))
+            return;
+
+        if (!_database.updateState(Database::Section::encoder_t::valueStored, i, 1))
+            return;
+
+        changed[i / 32] &= ~(static_cast<uint32_t>(1) << (i % 32));
+    });
+}
+
+/// Groups encoders with remote sync enabled by MIDI ID and stores the channel and ID
+/// on which each of them listens so that database isn't accessed for incoming messages.
+void Encoders::buildRemoteSyncLookup()
+{
+    _remoteSyncLookup.clear();
+    _remoteSyncRevision = _database.revision();
+    _remoteSyncValid    = true;
+
+    for (size_t i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        _remoteSyncKey[i] = NO_REMOTE_SYNC;
+
+        if (!_database.read(Database::Section::encoder_t::remoteSync, i))
+            continue;
+
+        if (_database.read(Database::Section::encoder_t::mode, i) != static_cast<int32_t>(type_t::controlChange))
+            continue;
+
+        uint8_t midiID = _database.read(Database::Section::encoder_t::midiID, i);
+
+        _remoteSyncKey[i] = remoteSyncKey(_database.read(Database::Section::encoder_t::midiChannel, i), midiID);
+        _remoteSyncLookup.assign(i, midiID);
+    }
+}
+
+/// Copies enable state of all encoders from database so that disabled
+/// encoders can be skipped without accessing database in update.
+void Encoders::buildEnableBitmap()
+{
+    _enabled         = {};
+    _enabledRevision = _database.revision();
+    _enabledValid    = true;
+
+    for (size_t i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        if (_database.read(Database::Section::encoder_t::enable, i))
+            _enabled[i / 32] |= static_cast<uint32_t>(1) << (i % 32);
+    }
 }
 
 void Encoders::fillEncoderDescriptor(size_t index, encoderDescriptor_t& descriptor)
 {
     descriptor.type          = static_cast<type_t>(_database.read(Database::Section::encoder_t::mode, index));
     descriptor.pulsesPerStep = _database.read(Database::Section::encoder_t::pulsesPerStep, index);
+    descriptor.invert        = _database.read(Database::Section::encoder_t::invert, index);
+    descriptor.acceleration  = _database.read(Database::Section::encoder_t::acceleration, index);
+
+    //high resolution mode sends every pulse so that movement between two detents isn't lost
+    if (descriptor.type == type_t::nrpn14bitRelative)
+        descriptor.pulsesPerStep = 1;
 
     descriptor.dispatchMessage.componentIndex = index;
     descriptor.dispatchMessage.midiChannel    = _database.read(Database::Section::encoder_t::midiChannel, index);
@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "database/Database.h"
 #include "util/messaging/Messaging.h"
+#include "io/common/Common.h"
 
 #ifndef ENCODERS_SUPPORTED
 #include "stub/Encoders.h"
@@ -41,6 +42,8 @@ namespace IO
             nrpn7bit,
             nrpn14bit,
             controlChange14bit,
+            controlChange41h01h,
+            nrpn14bitRelative,
             AMOUNT
         };
 
@@ -60,11 +63,38 @@ namespace IO
             AMOUNT
         };
 
+        using changedBitmap_t = Common::bitmap_t<MAX_NUMBER_OF_ENCODERS>;
+
+        /// Amount of points in each acceleration curve.
+        static constexpr size_t ACCELERATION_CURVE_POINTS = 8;
+
+        /// Amount of acceleration curves, one for every acceleration type except disabled.
+        static constexpr size_t ACCELERATION_CURVES = static_cast<size_t>(acceleration_t::AMOUNT) - 1;
+
+        /// Encoder speed in steps per second for every curve point.
+        static constexpr uint16_t ACCELERATION_CURVE_SPEED[ACCELERATION_CURVE_POINTS] = { 6, 10, 15, 20, 30, 40, 60, 80 };
+
+        /// Default value change per step in 7-bit modes for every curve point of slow, medium and fast curve.
+        static constexpr uint8_t ACCELERATION_CURVE_DEFAULT[ACCELERATION_CURVES * ACCELERATION_CURVE_POINTS] = {
+            1, 1, 1, 2, 2, 3, 4, 5,       //slow
+            1, 1, 2, 3, 4, 6, 8, 10,      //medium
+            1, 2, 3, 5, 8, 16, 32, 64,    //fast
+        };
+
+        /// Time in milliseconds without any value change after which the changed values are
+        /// written to database. All the changes made in the meantime result in single write.
+        static constexpr uint32_t VALUE_STORE_DELAY = 3000;
+
         class HWA
         {
             public:
-            //should return true if the value has been refreshed, false otherwise
-            virtual bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) = 0;
+            //should set the bits of all encoders which could have changed since the last call
+            //and return true if at least one bit is set, false otherwise
+            virtual bool changed(changedBitmap_t& bitmap) = 0;
+
+            //should store the amount of pulses decoded by board since the last call,
+            //positive in clockwise direction, and return true if the value has been refreshed
+            virtual bool pulses(size_t index, int16_t& pulses) = 0;
         };
 
         class Filter
@@ -81,12 +111,12 @@ namespace IO
 
         Encoders(HWA&                     hwa,
                  Filter&                  filter,
-                 uint32_t                 timeDiffTimeout,
                  Database&                database,
                  Util::MessageDispatcher& dispatcher);
 
         void update();
         void resetValue(size_t index);
+        void storeValues();
 
         private:
         HWA&    _hwa;
@@ -96,94 +126,107 @@ namespace IO
         {
             type_t                             type          = type_t::controlChange7Fh01h;
             uint8_t                            pulsesPerStep = 0;
+            bool                               invert        = false;
+            uint8_t                            acceleration  = 0;
             Util::MessageDispatcher::message_t dispatchMessage;
 
             encoderDescriptor_t() = default;
         };
 
-        /// Time difference betweeen multiple encoder readouts in milliseconds.
-        const uint32_t TIME_DIFF_READOUT;
+        /// Movement of single encoder accumulated during single update.
+        struct movement_t
+        {
+            int16_t steps = 0;    ///< Amount of steps, positive in clockwise direction.
+            int32_t delta = 0;    ///< Change of absolute value with acceleration applied.
+        };
 
         Database&                _database;
         Util::MessageDispatcher& _dispatcher;
 
-        void       fillEncoderDescriptor(size_t index, encoderDescriptor_t& descriptor);
-        position_t read(size_t index, uint8_t pairState);
-        void       processReading(size_t index, uint8_t pairValue, uint32_t sampleTime);
-        void       sendMessage(size_t index, encoderDescriptor_t& descriptor);
-        void       setValue(size_t index, uint16_t value);
+        void     fillEncoderDescriptor(size_t index, encoderDescriptor_t& descriptor);
+        void     processPulses(size_t index, const encoderDescriptor_t& descriptor, int16_t pulses, uint32_t sampleTime, uint32_t elapsed, movement_t& movement);
+        void     processPosition(size_t index, const encoderDescriptor_t& descriptor, position_t position, uint32_t sampleTime, movement_t& movement);
+        void     sendMovement(size_t index, encoderDescriptor_t& descriptor, const movement_t& movement);
+        uint32_t registerStep(size_t index, uint32_t sampleTime);
+        uint16_t acceleratedChange(const encoderDescriptor_t& descriptor, uint32_t speed);
+        void     sendMessage(size_t index, encoderDescriptor_t& descriptor);
+        void     setValue(size_t index, uint16_t value);
+        void     resetState(size_t index);
+        void     buildRemoteSyncLookup();
+        void     buildEnableBitmap();
+        void     selectValuePreset();
+        void     valueChanged(size_t index);
+        int16_t  defaultValue(size_t index);
+        void     storeValues(uint32_t currentTime);
+
+        static constexpr bool use14bit(type_t type)
+        {
+            return (type == type_t::pitchBend) || (type == type_t::nrpn14bit) || (type == type_t::controlChange14bit);
+        }
 
-        /// Time threshold in milliseconds between two encoder steps used to detect fast movement.
-        static constexpr uint32_t ENCODERS_SPEED_TIMEOUT = 140;
+        static constexpr uint16_t remoteSyncKey(uint8_t channel, uint8_t midiID)
+        {
+            return (static_cast<uint16_t>(channel) << 7) | (midiID & 0x7F);
+        }
 
-        /// Holds current MIDI value for all encoders.
-        int16_t _midiValue[MAX_NUMBER_OF_ENCODERS] = { 0 };
+        /// Key stored for encoders which don't react to incoming messages.
+        static constexpr uint16_t NO_REMOTE_SYNC = 0xFFFF;
 
-        /// Array holding current speed (in steps) for all encoders.
-        uint8_t _encoderSpeed[MAX_NUMBER_OF_ENCODERS] = {};
+        /// Amount of intervals between steps used to calculate the speed of encoder.
+        static constexpr size_t SPEED_WINDOW = 4;
 
-        /// Array holding last two readings from encoder pins.
-        uint8_t _encoderData[MAX_NUMBER_OF_ENCODERS] = {};
+        /// MIDI channel and ID on which each encoder listens for remote sync.
+        uint16_t _remoteSyncKey[MAX_NUMBER_OF_ENCODERS] = {};
 
-        /// Array holding current amount of pulses for all encoders.
-        int8_t _encoderPulses[MAX_NUMBER_OF_ENCODERS] = {};
+        /// Encoders with remote sync enabled grouped by MIDI ID.
+        Common::ComponentIndex<MAX_NUMBER_OF_ENCODERS, 128> _remoteSyncLookup;
 
-        /// Lookup table used to convert encoder reading to pulses.
-        const int8_t _encoderLookUpTable[16] = {
-            0,     //0000
-            1,     //0001
-            -1,    //0010
-            0,     //0011
-            -1,    //0100
-            0,     //0101
-            0,     //0110
-            1,     //0111
-            1,     //1000
-            0,     //1001
-            0,     //1010
-            -1,    //1011
-            0,     //1100
-            -1,    //1101
-            1,     //1110
-            0      //1111
-        };
+        /// Database revision for which the remote sync lookup has been built.
+        uint32_t _remoteSyncRevision = 0;
+        bool     _remoteSyncValid    = false;
 
-        /// Used to achieve linear encoder acceleration on fast movement.
-        /// Every time fast movement is detected, amount of steps is increased by this value.
-        /// Used only in CC/Pitch bend/NRPN modes. In Pitch bend/NRPN modes, this value is multiplied
-        /// by 4 due to a larger value range.
-        const uint8_t _encoderSpeedChange[static_cast<uint8_t>(IO::Encoders::acceleration_t::AMOUNT)] = {
-            0,    //acceleration disabled
-            1,
-            2,
-            3
-        };
+        /// Enable state of all encoders copied from database.
+        changedBitmap_t _enabled = {};
 
-        /// Maximum value by which MIDI value is increased during acceleration.
-        const uint8_t _encoderMaxAccSpeed[static_cast<uint8_t>(IO::Encoders::acceleration_t::AMOUNT)] = {
-            0,    //acceleration disabled
-            5,
-            10,
-            100
-        };
+        /// Database revision for which the enable bitmap has been built.
+        uint32_t _enabledRevision = 0;
+        bool     _enabledValid    = false;
 
-        /// Array used for easier access to current encoder MIDI value in 7Fh01h and 3Fh41h modes.
-        /// Matched with type_t and position_t
-        const uint8_t _encValue[2][3] = {
-            //controlChange7Fh01h
-            {
-                0,      //stopped
-                127,    //ccw
-                1       //cw
-            },
-
-            //controlChange3Fh41h
-            {
-                0,     //stopped
-                63,    //ccw
-                65     //cw
-            }
-        };
+        /// Holds current MIDI value for all encoders in every preset.
+        /// Values of inactive presets are kept so that they are restored on preset change
+        /// without accessing database. Preset values are read from database only once,
+        /// when the preset is selected for the first time.
+        int16_t _midiValue[Database::MAX_PRESETS][MAX_NUMBER_OF_ENCODERS] = {};
+
+        /// Values which have been changed, but not yet written to database.
+        changedBitmap_t _valueChanged[Database::MAX_PRESETS] = {};
+
+        /// Bitmask of presets whose values have been read from database.
+        uint16_t _valuePresetLoaded = 0;
+
+        /// Database state revision for which the loaded values are valid.
+        uint32_t _valueStateRevision = 0;
+
+        static_assert(Database::MAX_PRESETS <= 16, "Preset bitmask too small");
+
+        /// Preset whose values are currently used.
+        uint8_t _valuePreset = 0;
+
+        /// Time of the last change of any value in active preset.
+        uint32_t _lastValueChangeTime = 0;
+
+        /// Time of the last update. Used to find out over which period the pulses decoded by board have been made.
+        uint32_t _lastUpdateTime = 0;
+
+        /// Time in milliseconds between the last SPEED_WINDOW steps of each encoder, newest last.
+        /// Limited to 255 ms since slower movement isn't accelerated anyway.
+        uint8_t _stepInterval[MAX_NUMBER_OF_ENCODERS][SPEED_WINDOW] = {};
+
+        /// Time of the last step of each encoder, truncated to 16 bits.
+        uint16_t _lastStepTime[MAX_NUMBER_OF_ENCODERS] = {};
+
+        /// Pulses of each encoder which haven't yet made up complete step, positive in clockwise direction.
+        int8_t _encoderPulses[MAX_NUMBER_OF_ENCODERS] = {};
 
         const MIDI::messageType_t _internalMsgToMIDIType[static_cast<uint8_t>(type_t::AMOUNT)] = {
             MIDI::messageType_t::controlChange,
@@ -195,6 +238,8 @@ namespace IO
             MIDI::messageType_t::nrpn7bit,
             MIDI::messageType_t::nrpn14bit,
             MIDI::messageType_t::controlChange14bit,
+            MIDI::messageType_t::controlChange,
+            MIDI::messageType_t::nrpn14bit,
         };
     };
 }    // namespace IO
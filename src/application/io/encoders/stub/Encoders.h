@@ -18,6 +18,8 @@ limitations under the License.
 
 #pragma once
 
+#include "io/common/Common.h"
+
 namespace IO
 {
     class Encoders
@@ -34,6 +36,8 @@ namespace IO
             nrpn7bit,
             nrpn14bit,
             controlChange14bit,
+            controlChange41h01h,
+            nrpn14bitRelative,
             AMOUNT
         };
 
@@ -53,10 +57,22 @@ namespace IO
             AMOUNT
         };
 
+        using changedBitmap_t = Common::bitmap_t<MAX_NUMBER_OF_ENCODERS>;
+
+        static constexpr size_t   ACCELERATION_CURVE_POINTS                                                   = 8;
+        static constexpr size_t   ACCELERATION_CURVES                                                         = static_cast<size_t>(acceleration_t::AMOUNT) - 1;
+        static constexpr uint16_t ACCELERATION_CURVE_SPEED[ACCELERATION_CURVE_POINTS]                         = { 6, 10, 15, 20, 30, 40, 60, 80 };
+        static constexpr uint8_t  ACCELERATION_CURVE_DEFAULT[ACCELERATION_CURVES * ACCELERATION_CURVE_POINTS] = {
+            1, 1, 1, 2, 2, 3, 4, 5,       //slow
+            1, 1, 2, 3, 4, 6, 8, 10,      //medium
+            1, 2, 3, 5, 8, 16, 32, 64,    //fast
+        };
+
         class HWA
         {
             public:
-            virtual bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) = 0;
+            virtual bool changed(changedBitmap_t& bitmap)      = 0;
+            virtual bool pulses(size_t index, int16_t& pulses) = 0;
         };
 
         class Filter
@@ -72,7 +88,6 @@ namespace IO
 
         Encoders(HWA&                     hwa,
                  Filter&                  filter,
-                 uint32_t                 timeDiffTimeout,
                  Database&                database,
                  Util::MessageDispatcher& dispatcher)
         {}
@@ -92,5 +107,9 @@ namespace IO
         void setValue(size_t index, uint16_t value)
         {
         }
+
+        void storeValues()
+        {
+        }
     };
 }    // namespace IO
\ No newline at end of file
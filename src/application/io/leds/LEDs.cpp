@@ -126,6 +126,9 @@ void LEDs::init(bool startUp)
     }
 
     setBlinkType(static_cast<blinkType_t>(_database.read(Database::Section::leds_t::global, setting_t::blinkWithMIDIclock)));
+
+    //configuration could have been changed, rebuild lookup table once it's needed
+    _lookupValid = false;
 }
 
 void LEDs::update(bool forceChange)
@@ -233,17 +236,19 @@ LEDs::brightness_t LEDs::valueToBrightness(uint8_t value)
 
 void LEDs::midiToState(MIDI::messageType_t messageType, uint8_t value1, uint8_t value2, uint8_t channel, Util::MessageDispatcher::messageSource_t source)
 {
-    for (size_t i = 0; i < MAX_LEDS; i++)
-    {
+    if (!_lookupValid)
+        buildLookup();
+
+    auto process = [&](size_t i) {
         auto controlType = static_cast<controlType_t>(_database.read(Database::Section::leds_t::controlType, i));
 
         //match received midi message with the assigned LED control type
         if (!isControlTypeMatched(messageType, controlType))
-            continue;
+            return;
 
         //no point in checking if channel doesn't match
         if (_database.read(Database::Section::leds_t::midiChannel, i) != channel)
-            continue;
+            return;
 
         bool setState = false;
         bool setBlink = false;
@@ -413,14 +418,40 @@ void LEDs::midiToState(MIDI::messageType_t messageType, uint8_t value1, uint8_t
                 }
             }
         }
+    };
+
+    //only the LEDs with matching activation ID can react to note and CC messages,
+    //while all LEDs controlled with program change need to be updated on every program
+    _lookup.forEach(messageType == MIDI::messageType_t::programChange ? PC_LOOKUP_KEY : value1, process);
+}
+
+void LEDs::buildLookup()
+{
+    _lookup.clear();
+    _lookupValid = true;
+
+    if constexpr (!decltype(_lookup)::INDEXED)
+        return;
+
+    for (size_t i = 0; i < MAX_LEDS; i++)
+    {
+        auto controlType = static_cast<controlType_t>(_database.read(Database::Section::leds_t::controlType, i));
+
+        if (controlType >= controlType_t::AMOUNT)
+            continue;
+
+        if (controlTypeToMIDImessage[static_cast<uint8_t>(controlType)] == MIDI::messageType_t::programChange)
+            _lookup.assign(i, PC_LOOKUP_KEY);
+        else
+            _lookup.assign(i, _database.read(Database::Section::leds_t::activationID, i));
     }
 }
 
-void LEDs::setBlinkSpeed(uint8_t ledID, blinkSpeed_t state)
+void LEDs::setBlinkSpeed(size_t ledID, blinkSpeed_t state)
 {
-    uint8_t ledArray[3] = {};
+    size_t  ledArray[3] = {};
     uint8_t leds        = 0;
-    uint8_t rgbIndex    = _hwa.rgbIndex(ledID);
+    size_t  rgbIndex    = _hwa.rgbIndex(ledID);
 
     if (_database.read(Database::Section::leds_t::rgbEnable, rgbIndex))
     {
@@ -477,11 +508,11 @@ void LEDs::refresh()
         _hwa.setState(i, _brightness[i]);
 }
 
-void LEDs::setColor(uint8_t ledID, color_t color, brightness_t brightness)
+void LEDs::setColor(size_t ledID, color_t color, brightness_t brightness)
 {
-    uint8_t rgbIndex = _hwa.rgbIndex(ledID);
+    size_t rgbIndex = _hwa.rgbIndex(ledID);
 
-    auto handleLED = [&](uint8_t index, rgbIndex_t rgbIndex, bool state, bool isRGB) {
+    auto handleLED = [&](size_t index, rgbIndex_t rgbIndex, bool state, bool isRGB) {
         if (state)
         {
             updateBit(index, ledBit_t::active, true);
@@ -531,9 +562,9 @@ void LEDs::setColor(uint8_t ledID, color_t color, brightness_t brightness)
     {
         //rgb led is composed of three standard LEDs
         //get indexes of individual LEDs first
-        uint8_t rLED = _hwa.rgbSignalIndex(rgbIndex, rgbIndex_t::r);
-        uint8_t gLED = _hwa.rgbSignalIndex(rgbIndex, rgbIndex_t::g);
-        uint8_t bLED = _hwa.rgbSignalIndex(rgbIndex, rgbIndex_t::b);
+        size_t rLED = _hwa.rgbSignalIndex(rgbIndex, rgbIndex_t::r);
+        size_t gLED = _hwa.rgbSignalIndex(rgbIndex, rgbIndex_t::g);
+        size_t bLED = _hwa.rgbSignalIndex(rgbIndex, rgbIndex_t::b);
 
         handleLED(rLED, rgbIndex_t::r, BIT_READ(static_cast<uint8_t>(color), static_cast<uint8_t>(rgbIndex_t::r)), true);
         handleLED(gLED, rgbIndex_t::g, BIT_READ(static_cast<uint8_t>(color), static_cast<uint8_t>(rgbIndex_t::g)), true);
@@ -545,7 +576,7 @@ void LEDs::setColor(uint8_t ledID, color_t color, brightness_t brightness)
     }
 }
 
-IO::LEDs::blinkSpeed_t LEDs::blinkSpeed(uint8_t ledID)
+IO::LEDs::blinkSpeed_t LEDs::blinkSpeed(size_t ledID)
 {
     return static_cast<blinkSpeed_t>(_blinkTimer[ledID]);
 }
@@ -594,17 +625,17 @@ void LEDs::resetBlinking()
     }
 }
 
-void LEDs::updateBit(uint8_t index, ledBit_t bit, bool state)
+void LEDs::updateBit(size_t index, ledBit_t bit, bool state)
 {
     BIT_WRITE(_ledState[index], static_cast<uint8_t>(bit), state);
 }
 
-bool LEDs::bit(uint8_t index, ledBit_t bit)
+bool LEDs::bit(size_t index, ledBit_t bit)
 {
     return BIT_READ(_ledState[index], static_cast<uint8_t>(bit));
 }
 
-LEDs::color_t LEDs::color(uint8_t ledID)
+LEDs::color_t LEDs::color(size_t ledID)
 {
     if (!bit(ledID, ledBit_t::active))
     {
@@ -620,7 +651,7 @@ LEDs::color_t LEDs::color(uint8_t ledID)
         else
         {
             //rgb led
-            uint8_t rgbIndex = _hwa.rgbIndex(ledID);
+            size_t rgbIndex = _hwa.rgbIndex(ledID);
 
             uint8_t color = 0;
             color |= bit(_hwa.rgbSignalIndex(rgbIndex, rgbIndex_t::b), ledBit_t::rgb_b);
@@ -634,7 +665,7 @@ LEDs::color_t LEDs::color(uint8_t ledID)
     }
 }
 
-void LEDs::resetState(uint8_t index)
+void LEDs::resetState(size_t index)
 {
     _ledState[index]   = 0;
     _brightness[index] = brightness_t::bOff;
@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "database/Database.h"
 #include "util/messaging/Messaging.h"
+#include "io/common/Common.h"
 
 #ifndef LEDS_SUPPORTED
 #include "stub/LEDs.h"
@@ -115,10 +116,10 @@ namespace IO
         void         setAllOn();
         void         setAllOff();
         void         refresh();
-        void         setColor(uint8_t ledID, color_t color, brightness_t brightness);
-        color_t      color(uint8_t ledID);
-        void         setBlinkSpeed(uint8_t ledID, blinkSpeed_t value);
-        blinkSpeed_t blinkSpeed(uint8_t ledID);
+        void         setColor(size_t ledID, color_t color, brightness_t brightness);
+        color_t      color(size_t ledID);
+        void         setBlinkSpeed(size_t ledID, blinkSpeed_t value);
+        blinkSpeed_t blinkSpeed(size_t ledID);
         size_t       rgbSignalIndex(size_t rgbIndex, LEDs::rgbIndex_t rgbComponent);
         size_t       rgbIndex(size_t singleLEDindex);
         void         setBlinkType(blinkType_t blinkType);
@@ -136,15 +137,16 @@ namespace IO
             rgb_b       ///< B index of RGB LED
         };
 
-        void         updateBit(uint8_t index, ledBit_t bit, bool state);
-        bool         bit(uint8_t index, ledBit_t bit);
-        void         resetState(uint8_t index);
+        void         updateBit(size_t index, ledBit_t bit, bool state);
+        bool         bit(size_t index, ledBit_t bit);
+        void         resetState(size_t index);
         color_t      valueToColor(uint8_t receivedVelocity);
         blinkSpeed_t valueToBlinkSpeed(uint8_t value);
         brightness_t valueToBrightness(uint8_t value);
         void         startUpAnimation();
         bool         isControlTypeMatched(MIDI::messageType_t midiMessage, controlType_t controlType);
         void         midiToState(MIDI::messageType_t messageType, uint8_t value1, uint8_t value2, uint8_t channel, Util::MessageDispatcher::messageSource_t source);
+        void         buildLookup();
 
         HWA&      _hwa;
         Database& _database;
@@ -154,6 +156,10 @@ namespace IO
         static constexpr size_t  TOTAL_BRIGHTNESS_VALUES         = 4;
         static constexpr uint8_t LED_BLINK_TIMER_TYPE_CHECK_TIME = 50;
 
+        /// Key under which LEDs controlled with program change are grouped in lookup table.
+        /// These LEDs react to every program, not only to the one matching activation ID.
+        static constexpr size_t PC_LOOKUP_KEY = 128;
+
         /// Array holding current LED status for all LEDs.
         uint8_t _ledState[MAX_LEDS] = {};
 
@@ -194,6 +200,12 @@ namespace IO
         /// Holds last time in miliseconds when LED blinking has been updated.
         uint32_t _lastLEDblinkUpdateTime = 0;
 
+        /// LEDs grouped by activation ID used to find LEDs which should react to incoming message.
+        Common::ComponentIndex<MAX_LEDS, PC_LOOKUP_KEY + 1> _lookup;
+
+        /// Set once the lookup table matches the configuration in database.
+        bool _lookupValid = false;
+
         const MIDI::messageType_t controlTypeToMIDImessage[static_cast<uint8_t>(controlType_t::AMOUNT)] = {
             MIDI::messageType_t::noteOn,           //midiInNoteSingleVal,
             MIDI::messageType_t::noteOn,           //localNoteSingleVal,
@@ -137,20 +137,20 @@ namespace IO
         {
         }
 
-        void setColor(uint8_t ledID, color_t color)
+        void setColor(size_t ledID, color_t color)
         {
         }
 
-        color_t color(uint8_t ledID)
+        color_t color(size_t ledID)
         {
             return color_t::off;
         }
 
-        void setBlinkSpeed(uint8_t ledID, blinkSpeed_t value)
+        void setBlinkSpeed(size_t ledID, blinkSpeed_t value)
         {
         }
 
-        blinkSpeed_t blinkSpeed(uint8_t ledID)
+        blinkSpeed_t blinkSpeed(size_t ledID)
         {
             return blinkSpeed_t::noBlink;
         }
@@ -234,48 +234,89 @@ class HWADigitalIn
     HWADigitalIn() = default;
 
 #ifdef BUTTONS_SUPPORTED
-    bool buttonState(size_t index, uint8_t& numberOfReadings, uint32_t& states)
+    bool buttonState(size_t index, uint8_t& numberOfReadings, uint32_t& states, bool& debounced)
     {
         if (!Board::io::digitalInState(index, dInReadA))
             return false;
 
+        //raw history is used by debouncing profiles which run in application
         numberOfReadings = dInReadA.count;
         states           = dInReadA.readings;
+        debounced        = dInReadA.debounced;
 
         return true;
     }
-#endif
 
-#ifdef ENCODERS_SUPPORTED
-    bool encoderState(size_t index, uint8_t& numberOfReadings, uint32_t& states)
+    bool buttonsChanged(IO::Buttons::changedBitmap_t& bitmap)
     {
-        if (!Board::io::digitalInState(Board::io::encoderSignalIndex(index, Board::io::encoderIndex_t::a), dInReadA))
-            return false;
+        pullChanges();
 
-        if (!Board::io::digitalInState(Board::io::encoderSignalIndex(index, Board::io::encoderIndex_t::b), dInReadB))
-            return false;
+        bool anyChanged = false;
 
-        numberOfReadings = dInReadA.count > dInReadB.count ? dInReadA.count : dInReadB.count;
+        for (size_t word = 0; word < bitmap.size(); word++)
+        {
+            bitmap[word]          = _buttonsChanged[word];
+            _buttonsChanged[word] = 0;
 
-        //construct encoder pair readings
-        //encoder signal is made of A and B signals
-        //take each bit of A signal and B signal and append it to states variable in order
-        //latest encoder readings should be in LSB bits
+            if (bitmap[word])
+                anyChanged = true;
+        }
 
-        for (uint8_t i = 0; i < numberOfReadings; i++)
+        return anyChanged;
+    }
+#endif
+
+#ifdef ENCODERS_SUPPORTED
+    bool encodersChanged(IO::Encoders::changedBitmap_t& bitmap)
+    {
+        pullChanges();
+
+        bool anyChanged = false;
+
+        for (size_t word = 0; word < bitmap.size(); word++)
         {
-            BIT_WRITE(states, (i * 2) + 1, (dInReadA.readings >> i & 0x01));
-            BIT_WRITE(states, i * 2, (dInReadB.readings >> i & 0x01));
+            bitmap[word]           = _encodersChanged[word];
+            _encodersChanged[word] = 0;
+
+            if (bitmap[word])
+                anyChanged = true;
         }
 
-        return true;
+        return anyChanged;
     }
 #endif
 
     private:
+    /// Retrieves changed digital inputs from board and stores them separately for buttons and encoders
+    /// since board clears its bitmap once it's read.
+    void pullChanges()
+    {
+        Board::io::dInBitmap_t changed;
+
+        if (!Board::io::digitalInChanged(changed))
+            return;
+
+#ifdef BUTTONS_SUPPORTED
+        for (size_t word = 0; word < changed.size(); word++)
+            _buttonsChanged[word] |= changed[word];
+#endif
+
+#ifdef ENCODERS_SUPPORTED
+        IO::Common::forEachSetBit(changed, [this](size_t index) {
+            size_t encoderIndex = Board::io::encoderIndex(index);
+
+            if (encoderIndex < MAX_NUMBER_OF_ENCODERS)
+                _encodersChanged[encoderIndex / 32] |= (static_cast<uint32_t>(1) << (encoderIndex % 32));
+        });
+#endif
+    }
+
     Board::io::dInReadings_t dInReadA;
+#ifdef BUTTONS_SUPPORTED
+    IO::Buttons::changedBitmap_t _buttonsChanged = {};
+#endif
 #ifdef ENCODERS_SUPPORTED
-    Board::io::dInReadings_t dInReadB;
+    IO::Encoders::changedBitmap_t _encodersChanged = {};
 #endif
 } _hwaDigitalIn;
 #endif
@@ -292,9 +333,19 @@ class HWAButtons : public System::HWA::IO::Buttons
         return true;
     }
 
-    bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) override
+    bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states, bool& debounced) override
     {
-        return _hwaDigitalIn.buttonState(index, numberOfReadings, states);
+        return _hwaDigitalIn.buttonState(index, numberOfReadings, states, debounced);
+    }
+
+    bool changed(IO::Buttons::changedBitmap_t& bitmap) override
+    {
+        return _hwaDigitalIn.buttonsChanged(bitmap);
+    }
+
+    bool edgeTime(size_t index, uint32_t& time) override
+    {
+        return Board::io::digitalInEdgeTime(index, time);
     }
 
     size_t buttonToEncoderIndex(size_t index) override
@@ -313,7 +364,17 @@ class HWAButtonsStub : public System::HWA::IO::Buttons
         return false;
     }
 
-    bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) override
+    bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states, bool& debounced) override
+    {
+        return false;
+    }
+
+    bool changed(IO::Buttons::changedBitmap_t& bitmap) override
+    {
+        return false;
+    }
+
+    bool edgeTime(size_t index, uint32_t& time) override
     {
         return false;
     }
@@ -337,9 +398,14 @@ class HWAEncoders : public System::HWA::IO::Encoders
         return true;
     }
 
-    bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) override
+    bool changed(IO::Encoders::changedBitmap_t& bitmap) override
     {
-        return _hwaDigitalIn.encoderState(index, numberOfReadings, states);
+        return _hwaDigitalIn.encodersChanged(bitmap);
+    }
+
+    bool pulses(size_t index, int16_t& pulses) override
+    {
+        return Board::io::encoderPulses(index, pulses);
     }
 } _hwaEncoders;
 #else
@@ -353,7 +419,12 @@ class HWAEncodersStub : public System::HWA::IO::Encoders
         return false;
     }
 
-    bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) override
+    bool changed(IO::Encoders::changedBitmap_t& bitmap) override
+    {
+        return false;
+    }
+
+    bool pulses(size_t index, int16_t& pulses) override
     {
         return false;
     }
@@ -962,6 +1033,20 @@ class HWASystem : public System::HWA
         return true;
     }
 
+    bool inputScanTime(System::inputScanTime_t& scanTime) override
+    {
+        Board::io::dInScanTime_t dInScanTime;
+
+        if (!Board::io::digitalInScanTime(dInScanTime))
+            return false;
+
+        scanTime.period = dInScanTime.period;
+        scanTime.last   = dInScanTime.last;
+        scanTime.max    = dInScanTime.max;
+
+        return true;
+    }
+
     System::HWA::IO& io() override
     {
         return _hwaIO;
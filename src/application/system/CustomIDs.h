@@ -35,5 +35,45 @@ limitations under the License.
 
 ///
 
+/// Bulk requests for SysEx protocol.
+/// Handled before the message reaches SysExConf since the message carries
+/// a run of parameters for single block and section:
+/// F0 ID0 ID1 ID2 STATUS PART REQUEST BLOCK SECTION INDEX_H INDEX_L COUNT [VALUE_H VALUE_L]... F7
+/// Values are present in set requests and in responses to get requests.
+/// Single response is sent once all the parameters have been processed.
+/// In case of an error, COUNT field in response contains the number of
+/// parameters processed before the error occurred.
+
+#define SYSEX_CR_BULK_GET 0x1E
+#define SYSEX_CR_BULK_SET 0x1F
+
+///
+
+/// Requests used to transfer the entire active preset as compressed binary stream.
+/// Dump is started with regular custom request after which the board sends:
+/// F0 ID0 ID1 ID2 STATUS PART REQUEST [PAYLOAD] F7
+/// PART is one of SYSEX_PRESET_PART_* values. Start payload is 16-bit database UID,
+/// data payload is run-length encoded list of 16-bit parameter values and end payload
+/// is the total amount of parameters. All of them are split into three 7-bit bytes.
+/// Load request uses the same messages with SYSEX_CR_PRESET_LOAD as the request.
+
+#define SYSEX_CR_PRESET_DUMP 0x20
+#define SYSEX_CR_PRESET_LOAD 0x21
+
+#define SYSEX_PRESET_PART_START 0x00
+#define SYSEX_PRESET_PART_DATA  0x01
+#define SYSEX_PRESET_PART_END   0x7F
+
+///
+
+/// Response to SYSEX_CR_INPUT_SCAN_TIME holds the time between two digital input scans,
+/// duration of the last scan and the longest scan duration since the previous request,
+/// all in nanoseconds. Each value is sent as two 14-bit values, higher one first.
+/// Request fails on boards which don't measure the scan duration.
+
+#define SYSEX_CR_INPUT_SCAN_TIME 0x22
+
+///
+
 /// Custom ID used when sending info about components to host.
 #define SYSEX_CM_COMPONENT_ID 0x49
\ No newline at end of file
@@ -20,58 +20,62 @@ limitations under the License.
 
 uint8_t System::SysExDataHandler::get(uint8_t block, uint8_t section, uint16_t index, uint16_t& value)
 {
-    auto sysExBlock = static_cast<System::block_t>(block);
-    auto result     = static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
+    return _system.onGet(block, section, index, value);
+}
 
-    switch (sysExBlock)
-    {
-    case System::block_t::global:
-    {
-        result = _system.onGetGlobal(static_cast<System::Section::global_t>(section), index, value);
-    }
-    break;
+uint8_t System::onGet(uint8_t block, uint8_t section, size_t index, uint16_t& value)
+{
+    auto descriptor = sysExSection(block, section);
 
-    case System::block_t::buttons:
-    {
-        result = _system.onGetButtons(static_cast<System::Section::button_t>(section), index, value);
-    }
-    break;
+    if (descriptor == nullptr)
+        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
 
-    case System::block_t::encoders:
-    {
-        result = _system.onGetEncoders(static_cast<System::Section::encoder_t>(section), index, value);
-    }
-    break;
+    auto result = checkBlockAccess(static_cast<block_t>(block));
 
-    case System::block_t::analog:
-    {
-        result = _system.onGetAnalog(static_cast<System::Section::analog_t>(section), index, value);
-    }
-    break;
+    if (result != SysExConf::DataHandler::STATUS_OK)
+        return result;
 
-    case System::block_t::leds:
+    if (descriptor->flags & SYSEX_SECTION_NOT_SUPPORTED)
+        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
+
+    int32_t readValue = 0;
+
+    if (descriptor->flags & SYSEX_SECTION_CUSTOM_GET)
     {
-        result = _system.onGetLEDs(static_cast<System::Section::leds_t>(section), index, value);
+        uint16_t customValue = 0;
+        result               = onGetCustom(static_cast<block_t>(block), section, index, customValue);
+        readValue            = customValue;
     }
-    break;
-
-    case System::block_t::display:
+    else
     {
-        result = _system.onGetDisplay(static_cast<System::Section::display_t>(section), index, value);
+        result = _database.read(static_cast<uint8_t>(dbBlock(block)), descriptor->dbSection, index, readValue) ? SysExConf::DataHandler::STATUS_OK : SysExConf::DataHandler::STATUS_ERROR_RW;
     }
-    break;
 
-    case System::block_t::touchscreen:
+    //channels start from 0 in db, start from 1 in sysex
+    if ((descriptor->flags & SYSEX_SECTION_MIDI_CHANNEL) && (result == SysExConf::DataHandler::STATUS_OK))
+        readValue++;
+
+    value = readValue;
+
+    return result;
+}
+
+uint8_t System::onGetCustom(block_t block, uint8_t section, size_t index, uint16_t& value)
+{
+    switch (block)
     {
-        result = _system.onGetTouchscreen(static_cast<System::Section::touchscreen_t>(section), index, value);
-    }
-    break;
+    case block_t::global:
+        return onGetGlobal(static_cast<Section::global_t>(section), index, value);
+
+    case block_t::leds:
+        return onGetLEDs(static_cast<Section::leds_t>(section), index, value);
+
+    case block_t::touchscreen:
+        return onGetTouchscreen(static_cast<Section::touchscreen_t>(section), index, value);
 
     default:
-        break;
+        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
     }
-
-    return result;
 }
 
 uint8_t System::onGetGlobal(Section::global_t section, size_t index, uint16_t& value)
@@ -188,85 +192,8 @@ uint8_t System::onGetGlobal(Section::global_t section, size_t index, uint16_t& v
     return result;
 }
 
-uint8_t System::onGetButtons(Section::button_t section, size_t index, uint16_t& value)
-{
-    if (!_hwa.io().buttons().supported())
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
-    int32_t readValue;
-    auto    result = _database.read(dbSection(section), index, readValue) ? SysExConf::DataHandler::STATUS_OK : SysExConf::DataHandler::STATUS_ERROR_RW;
-
-    //channels start from 0 in db, start from 1 in sysex
-    if ((section == Section::button_t::midiChannel) && (result == SysExConf::DataHandler::STATUS_OK))
-        readValue++;
-
-    value = readValue;
-
-    return result;
-}
-
-uint8_t System::onGetEncoders(Section::encoder_t section, size_t index, uint16_t& value)
-{
-    if (!_hwa.io().encoders().supported())
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
-    int32_t readValue;
-    auto    result = _database.read(dbSection(section), index, readValue) ? SysExConf::DataHandler::STATUS_OK : SysExConf::DataHandler::STATUS_ERROR_RW;
-
-    if (result == SysExConf::DataHandler::STATUS_OK)
-    {
-        if (section == Section::encoder_t::midiID_MSB)
-            return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
-        if (section == Section::encoder_t::midiChannel)
-        {
-            //channels start from 0 in db, start from 1 in sysex
-            readValue++;
-        }
-    }
-
-    value = readValue;
-
-    return result;
-}
-
-uint8_t System::onGetAnalog(Section::analog_t section, size_t index, uint16_t& value)
-{
-    if (!_hwa.io().analog().supported())
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
-    int32_t readValue;
-    auto    result = _database.read(dbSection(section), index, readValue) ? SysExConf::DataHandler::STATUS_OK : SysExConf::DataHandler::STATUS_ERROR_RW;
-
-    switch (section)
-    {
-    case Section::analog_t::midiID_MSB:
-    case Section::analog_t::lowerLimit_MSB:
-    case Section::analog_t::upperLimit_MSB:
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
-    case Section::analog_t::midiChannel:
-    {
-        //channels start from 0 in db, start from 1 in sysex
-        if (result == SysExConf::DataHandler::STATUS_OK)
-            readValue++;
-    }
-    break;
-
-    default:
-        break;
-    }
-
-    value = readValue;
-
-    return result;
-}
-
 uint8_t System::onGetLEDs(Section::leds_t section, size_t index, uint16_t& value)
 {
-    if (!_hwa.io().leds().supported())
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
     int32_t readValue;
     auto    result = SysExConf::DataHandler::STATUS_OK;
 
@@ -284,16 +211,6 @@ uint8_t System::onGetLEDs(Section::leds_t section, size_t index, uint16_t& value
     }
     break;
 
-    case Section::leds_t::midiChannel:
-    {
-        result = _database.read(dbSection(section), index, readValue) ? SysExConf::DataHandler::STATUS_OK : SysExConf::DataHandler::STATUS_ERROR_RW;
-
-        //channels start from 0 in db, start from 1 in sysex
-        if (result == SysExConf::DataHandler::STATUS_OK)
-            readValue++;
-    }
-    break;
-
     case Section::leds_t::rgbEnable:
     {
         result = _database.read(dbSection(section), _leds.rgbIndex(index), readValue) ? SysExConf::DataHandler::STATUS_OK : SysExConf::DataHandler::STATUS_ERROR_RW;
@@ -312,62 +229,39 @@ uint8_t System::onGetLEDs(Section::leds_t section, size_t index, uint16_t& value
     return result;
 }
 
-uint8_t System::onGetDisplay(Section::display_t section, size_t index, uint16_t& value)
-{
-    if (!_hwa.io().display().supported())
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
-    int32_t readValue;
-    auto    result = _database.read(dbSection(section), index, readValue) ? SysExConf::DataHandler::STATUS_OK : SysExConf::DataHandler::STATUS_ERROR_RW;
-
-    value = readValue;
-
-    return result;
-}
-
 uint8_t System::onGetTouchscreen(Section::touchscreen_t section, size_t index, uint16_t& value)
 {
-    if (!_hwa.io().touchscreen().supported())
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
-    if (!_touchscreen.isInitialized() && _hwa.serialPeripheralAllocated(serialPeripheral_t::touchscreen) && _backupRestoreState != backupRestoreState_t::none)
+    switch (section)
     {
-        return SERIAL_PERIPHERAL_ALLOCATED_ERROR;
-    }
-    else
+    case Section::touchscreen_t::setting:
     {
-        switch (section)
+        switch (index)
         {
-        case Section::touchscreen_t::setting:
+        case static_cast<size_t>(IO::Touchscreen::setting_t::cdcPassthrough):
         {
-            switch (index)
-            {
-            case static_cast<size_t>(IO::Touchscreen::setting_t::cdcPassthrough):
+            if (_database.read(Database::Section::global_t::dmx, dmxSetting_t::enabled))
             {
-                if (_database.read(Database::Section::global_t::dmx, dmxSetting_t::enabled))
+                if (_backupRestoreState != backupRestoreState_t::none)
                 {
-                    if (_backupRestoreState != backupRestoreState_t::none)
-                    {
-                        return CDC_ALLOCATED_ERROR;
-                    }
+                    return CDC_ALLOCATED_ERROR;
                 }
             }
-            break;
-
-            default:
-                break;
-            }
         }
         break;
 
         default:
             break;
         }
+    }
+    break;
 
-        int32_t readValue;
-        auto    result = _database.read(dbSection(section), index, readValue) ? SysExConf::DataHandler::STATUS_OK : SysExConf::DataHandler::STATUS_ERROR_RW;
-
-        value = readValue;
-        return result;
+    default:
+        break;
     }
+
+    int32_t readValue;
+    auto    result = _database.read(dbSection(section), index, readValue) ? SysExConf::DataHandler::STATUS_OK : SysExConf::DataHandler::STATUS_ERROR_RW;
+
+    value = readValue;
+    return result;
 }
\ No newline at end of file
@@ -17,74 +17,119 @@ limitations under the License.
 */
 
 #include "System.h"
+#include "SectionMap.h"
 
 Database::block_t System::dbBlock(uint8_t index)
 {
     //sysex blocks and db blocks don't have 1/1 mapping
 
-    auto sysExBlock = static_cast<block_t>(index);
+    if (index >= static_cast<uint8_t>(block_t::AMOUNT))
+        return Database::block_t::AMOUNT;
 
-    switch (sysExBlock)
-    {
-    case block_t::global:
-        return Database::block_t::global;
+    return blockMap[index].dbBlock;
+}
 
+/// Retrieves the descriptor for specified SysEx block and section.
+/// returns: Pointer to the descriptor or nullptr if block or section are out of range.
+const System::sysExSection_t* System::sysExSection(uint8_t block, uint8_t section)
+{
+    if (block >= static_cast<uint8_t>(block_t::AMOUNT))
+        return nullptr;
+
+    if (section >= blockMap[block].numberOfSections)
+        return nullptr;
+
+    return &blockMap[block].sections[section];
+}
+
+/// Verifies whether the specified SysEx block can be accessed at the moment.
+/// returns: SysExConf::DataHandler::STATUS_OK if block can be accessed, error code otherwise.
+uint8_t System::checkBlockAccess(block_t block)
+{
+    bool supported = true;
+
+    switch (block)
+    {
     case block_t::buttons:
-        return Database::block_t::buttons;
+    {
+        supported = _hwa.io().buttons().supported();
+    }
+    break;
 
     case block_t::encoders:
-        return Database::block_t::encoders;
+    {
+        supported = _hwa.io().encoders().supported();
+    }
+    break;
 
     case block_t::analog:
-        return Database::block_t::analog;
+    {
+        supported = _hwa.io().analog().supported();
+    }
+    break;
 
     case block_t::leds:
-        return Database::block_t::leds;
+    {
+        supported = _hwa.io().leds().supported();
+    }
+    break;
 
     case block_t::display:
-        return Database::block_t::display;
+    {
+        supported = _hwa.io().display().supported();
+    }
+    break;
 
     case block_t::touchscreen:
-        return Database::block_t::touchscreen;
+    {
+        if (!_hwa.io().touchscreen().supported())
+            return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
+
+        if (!_touchscreen.isInitialized() && _hwa.serialPeripheralAllocated(serialPeripheral_t::touchscreen) && _backupRestoreState != backupRestoreState_t::none)
+            return SERIAL_PERIPHERAL_ALLOCATED_ERROR;
+    }
+    break;
 
     default:
-        return Database::block_t::AMOUNT;
+        break;
     }
+
+    return supported ? SysExConf::DataHandler::STATUS_OK : static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
 }
 
 Database::Section::global_t System::dbSection(Section::global_t section)
 {
-    return _sysEx2DB_global[static_cast<uint8_t>(section)];
+    return static_cast<Database::Section::global_t>(globalSectionMap[static_cast<uint8_t>(section)].dbSection);
 }
 
 Database::Section::button_t System::dbSection(Section::button_t section)
 {
-    return _sysEx2DB_button[static_cast<uint8_t>(section)];
+    return static_cast<Database::Section::button_t>(buttonSectionMap[static_cast<uint8_t>(section)].dbSection);
 }
 
 Database::Section::encoder_t System::dbSection(Section::encoder_t section)
 {
-    return _sysEx2DB_encoder[static_cast<uint8_t>(section)];
+    return static_cast<Database::Section::encoder_t>(encoderSectionMap[static_cast<uint8_t>(section)].dbSection);
 }
 
 Database::Section::analog_t System::dbSection(Section::analog_t section)
 {
-    return _sysEx2DB_analog[static_cast<uint8_t>(section)];
+    return static_cast<Database::Section::analog_t>(analogSectionMap[static_cast<uint8_t>(section)].dbSection);
 }
 
 Database::Section::leds_t System::dbSection(Section::leds_t section)
 {
-    return _sysEx2DB_leds[static_cast<uint8_t>(section)];
+    return static_cast<Database::Section::leds_t>(ledSectionMap[static_cast<uint8_t>(section)].dbSection);
 }
 
 Database::Section::display_t System::dbSection(Section::display_t section)
 {
-    return _sysEx2DB_display[static_cast<uint8_t>(section)];
+    return static_cast<Database::Section::display_t>(displaySectionMap[static_cast<uint8_t>(section)].dbSection);
 }
 
 Database::Section::touchscreen_t System::dbSection(Section::touchscreen_t section)
 {
-    return _sysEx2DB_touchscreen[static_cast<uint8_t>(section)];
+    return static_cast<Database::Section::touchscreen_t>(touchscreenSectionMap[static_cast<uint8_t>(section)].dbSection);
 }
 
 bool System::isMIDIfeatureEnabled(midiFeature_t feature)
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "sysex/src/SysExConf.h"
+#include "io/buttons/Buttons.h"
 #include "io/leds/LEDs.h"
 #include "io/encoders/Encoders.h"
 #include "io/analog/Analog.h"
@@ -90,6 +91,62 @@ namespace
             MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_COMPONENTS,
             1,
             16,
+        },
+
+        //dual contact velocity curve section
+        {
+            IO::Buttons::DUAL_CONTACT_CURVE_POINTS,
+            0,
+            16383,
+        },
+
+        //debounce profile section
+        {
+            MAX_NUMBER_OF_BUTTONS,
+            0,
+            static_cast<uint16_t>(IO::Buttons::debounceProfile_t::AMOUNT) - 1,
+        },
+
+        //debounce press samples section
+        {
+            MAX_NUMBER_OF_BUTTONS,
+            1,
+            32,
+        },
+
+        //debounce release samples section
+        {
+            MAX_NUMBER_OF_BUTTONS,
+            1,
+            32,
+        },
+
+        //gesture long press time section
+        {
+            IO::Buttons::GESTURE_BUTTONS,
+            0,
+            255,
+        },
+
+        //gesture double tap time section
+        {
+            IO::Buttons::GESTURE_BUTTONS,
+            0,
+            255,
+        },
+
+        //gesture repeat time section
+        {
+            IO::Buttons::GESTURE_BUTTONS,
+            0,
+            255,
+        },
+
+        //gesture midi id section
+        {
+            IO::Buttons::GESTURE_BUTTONS,
+            0,
+            127,
         }
     };
 
@@ -156,6 +213,13 @@ namespace
             0,
             1,
         },
+
+        //acceleration curve section
+        {
+            IO::Encoders::ACCELERATION_CURVES * IO::Encoders::ACCELERATION_CURVE_POINTS,
+            1,
+            127,
+        },
     };
 
     std::vector<SysExConf::Section> analogSections = {
@@ -515,5 +579,15 @@ namespace
             .requestID     = SYSEX_CR_RESTORE_END,
             .connOpenCheck = true,
         },
+
+        {
+            .requestID     = SYSEX_CR_PRESET_DUMP,
+            .connOpenCheck = true,
+        },
+
+        {
+            .requestID     = SYSEX_CR_INPUT_SCAN_TIME,
+            .connOpenCheck = true,
+        },
     };
 }    // namespace
\ No newline at end of file
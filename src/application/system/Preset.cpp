@@ -0,0 +1,306 @@
+/*
+
+Copyright 2015-2021 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include "System.h"
+
+/// Sends all parameters from active preset as run-length encoded stream.
+/// Values are read directly from database, bypassing SysEx handlers.
+void System::presetDump()
+{
+    uint8_t message[PRESET_HEADER_SIZE + PRESET_CHUNK_SIZE + 1];
+    size_t  payloadSize = 0;
+    uint8_t status      = static_cast<uint8_t>(SysExConf::status_t::ack);
+
+    _presetDumpRequested = false;
+
+    auto send = [&](uint8_t part) {
+        message[0] = 0xF0;
+        message[1] = _sysExMID.id1;
+        message[2] = _sysExMID.id2;
+        message[3] = _sysExMID.id3;
+        message[4] = status;
+        message[5] = part;
+        message[6] = SYSEX_CR_PRESET_DUMP;
+
+        message[PRESET_HEADER_SIZE + payloadSize] = 0xF7;
+
+        //never send responses through DIN MIDI
+        _midi.sendSysEx(PRESET_HEADER_SIZE + payloadSize + 1, message, true, MIDI::interface_t::usb);
+        payloadSize = 0;
+    };
+
+    auto append = [&](uint8_t value) {
+        message[PRESET_HEADER_SIZE + payloadSize++] = value;
+    };
+
+    auto append14bit = [&](uint16_t value) {
+        append((value >> 7) & 0x7F);
+        append(value & 0x7F);
+    };
+
+    auto append21bit = [&](uint32_t value) {
+        append((value >> 14) & 0x7F);
+        append14bit(value & 0x3FFF);
+    };
+
+    //records never span across multiple chunks
+    auto reserve = [&](size_t size) {
+        if ((payloadSize + size) > PRESET_CHUNK_SIZE)
+            send(SYSEX_PRESET_PART_DATA);
+    };
+
+    uint16_t literals[PRESET_MAX_LITERALS];
+    uint8_t  literalCount = 0;
+
+    auto flushLiterals = [&]() {
+        if (!literalCount)
+            return;
+
+        reserve(1 + (literalCount * PRESET_VALUE_SIZE));
+        append(literalCount - 1);
+
+        for (size_t i = 0; i < literalCount; i++)
+            append21bit(literals[i]);
+
+        literalCount = 0;
+    };
+
+    Database::parameterCursor_t cursor;
+    bool                        remaining = true;
+    uint32_t                    total     = 0;
+
+    auto nextValue = [&](uint16_t& value) {
+        if (!remaining || (status != static_cast<uint8_t>(SysExConf::status_t::ack)))
+            return false;
+
+        int32_t readValue;
+
+        if (!_database.read(cursor.block, cursor.section, cursor.parameter, readValue))
+        {
+            status = static_cast<uint8_t>(SysExConf::status_t::errorRead);
+            return false;
+        }
+
+        //parameters are at most 16-bit wide, anything else can't be restored
+        if ((readValue < 0) || (readValue > 0xFFFF))
+        {
+            status = static_cast<uint8_t>(SysExConf::status_t::errorRead);
+            return false;
+        }
+
+        value     = readValue;
+        remaining = _database.nextParameter(cursor);
+        total++;
+
+        return true;
+    };
+
+    append21bit(_database.getDbUID());
+    send(SYSEX_PRESET_PART_START);
+
+    uint16_t current;
+    bool     currentValid = nextValue(current);
+
+    while (currentValid)
+    {
+        uint16_t next;
+        bool     nextValid;
+        uint8_t  count = 1;
+
+        while ((nextValid = nextValue(next)) && (next == current) && (count < PRESET_RECORD_MAX_COUNT))
+            count++;
+
+        if (count > 1)
+        {
+            flushLiterals();
+            reserve(1 + PRESET_VALUE_SIZE);
+            append(PRESET_RECORD_RUN | (count - 1));
+            append21bit(current);
+        }
+        else
+        {
+            literals[literalCount++] = current;
+
+            if (literalCount == PRESET_MAX_LITERALS)
+                flushLiterals();
+        }
+
+        current      = next;
+        currentValid = nextValid;
+    }
+
+    flushLiterals();
+
+    if (payloadSize)
+        send(SYSEX_PRESET_PART_DATA);
+
+    append21bit(total);
+    send(SYSEX_PRESET_PART_END);
+}
+
+/// Processes single message of preset load stream.
+/// param [in]: array   Received SysEx message.
+/// param [in]: size    Size of received message.
+/// returns: True if the message was preset load request (even invalid), false otherwise.
+bool System::handlePresetLoad(const uint8_t* array, size_t size)
+{
+    if (size < (PRESET_HEADER_SIZE + 1))
+        return false;
+
+    if ((array[1] != _sysExMID.id1) || (array[2] != _sysExMID.id2) || (array[3] != _sysExMID.id3))
+        return false;
+
+    if ((array[4] != static_cast<uint8_t>(SysExConf::status_t::request)) || (array[6] != SYSEX_CR_PRESET_LOAD))
+        return false;
+
+    const uint8_t* payload     = &array[PRESET_HEADER_SIZE];
+    const size_t   payloadSize = size - PRESET_HEADER_SIZE - 1;
+    const uint8_t  part        = array[5];
+    uint8_t        status      = static_cast<uint8_t>(SysExConf::status_t::ack);
+
+    auto merge21bit = [&]() {
+        return (static_cast<uint32_t>(payload[0]) << 14) | (payload[1] << 7) | payload[2];
+    };
+
+    if (!_sysExConf.isConfigurationEnabled())
+    {
+        status = static_cast<uint8_t>(SysExConf::status_t::errorConnection);
+    }
+    else
+    {
+        switch (part)
+        {
+        case SYSEX_PRESET_PART_START:
+        {
+            if (payloadSize != 3)
+            {
+                status = static_cast<uint8_t>(SysExConf::status_t::errorMessageLength);
+            }
+            else if (merge21bit() != _database.getDbUID())
+            {
+                //preset has been dumped from different database layout
+                status = static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
+            }
+            else
+            {
+                _presetLoadCursor    = {};
+                _presetLoadRemaining = true;
+                _presetLoadCount     = 0;
+                _presetLoadActive    = true;
+            }
+        }
+        break;
+
+        case SYSEX_PRESET_PART_DATA:
+        {
+            if (!_presetLoadActive)
+                status = static_cast<uint8_t>(SysExConf::status_t::errorPart);
+            else
+                status = presetLoadChunk(payload, payloadSize);
+
+            if (status != static_cast<uint8_t>(SysExConf::status_t::ack))
+                _presetLoadActive = false;
+        }
+        break;
+
+        case SYSEX_PRESET_PART_END:
+        {
+            if (!_presetLoadActive)
+            {
+                status = static_cast<uint8_t>(SysExConf::status_t::errorPart);
+            }
+            else
+            {
+                _presetLoadActive = false;
+
+                if ((payloadSize != 3) || (merge21bit() != _presetLoadCount) || _presetLoadRemaining)
+                    status = static_cast<uint8_t>(SysExConf::status_t::errorMessageLength);
+
+                //reapply active preset so that all components pick up new values
+                _database.setPreset(_database.getPreset());
+            }
+        }
+        break;
+
+        default:
+        {
+            status = static_cast<uint8_t>(SysExConf::status_t::errorPart);
+        }
+        break;
+        }
+    }
+
+    uint8_t response[PRESET_HEADER_SIZE + 1] = {
+        0xF0,
+        _sysExMID.id1,
+        _sysExMID.id2,
+        _sysExMID.id3,
+        status,
+        part,
+        SYSEX_CR_PRESET_LOAD,
+        0xF7
+    };
+
+    //never send responses through DIN MIDI
+    _midi.sendSysEx(sizeof(response), response, true, MIDI::interface_t::usb);
+
+    return true;
+}
+
+/// Decodes run-length encoded values and writes them to database.
+/// param [in]: payload Encoded records.
+/// param [in]: size    Amount of bytes in payload.
+/// returns: SysExConf status code.
+uint8_t System::presetLoadChunk(const uint8_t* payload, size_t size)
+{
+    size_t offset = 0;
+
+    while (offset < size)
+    {
+        const uint8_t header = payload[offset++];
+        const bool    run    = header & PRESET_RECORD_RUN;
+        const uint8_t count  = (header & (PRESET_RECORD_RUN - 1)) + 1;
+        const size_t  length = run ? PRESET_VALUE_SIZE : (count * PRESET_VALUE_SIZE);
+
+        if ((offset + length) > size)
+            return static_cast<uint8_t>(SysExConf::status_t::errorMessageLength);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const size_t   valueOffset = run ? offset : (offset + (i * PRESET_VALUE_SIZE));
+            const uint32_t value       = (static_cast<uint32_t>(payload[valueOffset]) << 14) | (payload[valueOffset + 1] << 7) | payload[valueOffset + 2];
+
+            if (value > 0xFFFF)
+                return static_cast<uint8_t>(SysExConf::status_t::errorNewValue);
+
+            //more values than parameters in preset
+            if (!_presetLoadRemaining)
+                return static_cast<uint8_t>(SysExConf::status_t::errorIndex);
+
+            if (!_database.update(_presetLoadCursor.block, _presetLoadCursor.section, _presetLoadCursor.parameter, value))
+                return static_cast<uint8_t>(SysExConf::status_t::errorWrite);
+
+            _presetLoadCount++;
+            _presetLoadRemaining = _database.nextParameter(_presetLoadCursor);
+        }
+
+        offset += length;
+    }
+
+    return static_cast<uint8_t>(SysExConf::status_t::ack);
+}
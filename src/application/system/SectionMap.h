@@ -0,0 +1,137 @@
+/*
+
+Copyright 2015-2021 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include "System.h"
+
+//maps sysex sections to sections in db together with the actions needed when section is accessed
+//every table must follow the order of sections defined in System::Section
+#define SYSEX_SECTION(dbSection, flags) \
+    {                                   \
+        static_cast<uint8_t>(dbSection), \
+        static_cast<uint8_t>(flags)      \
+    }
+
+namespace
+{
+    constexpr System::sysExSection_t globalSectionMap[] = {
+        SYSEX_SECTION(Database::Section::global_t::midiFeatures, System::SYSEX_SECTION_CUSTOM_GET | System::SYSEX_SECTION_CUSTOM_SET),
+        SYSEX_SECTION(Database::Section::global_t::midiMerge, System::SYSEX_SECTION_CUSTOM_GET | System::SYSEX_SECTION_CUSTOM_SET),
+        SYSEX_SECTION(Database::Section::global_t::AMOUNT, System::SYSEX_SECTION_CUSTOM_GET | System::SYSEX_SECTION_CUSTOM_SET),    //not in db
+        SYSEX_SECTION(Database::Section::global_t::dmx, System::SYSEX_SECTION_CUSTOM_GET | System::SYSEX_SECTION_CUSTOM_SET),
+    };
+
+    constexpr System::sysExSection_t buttonSectionMap[] = {
+        SYSEX_SECTION(Database::Section::button_t::type, System::SYSEX_SECTION_RESET_BUTTON),
+        SYSEX_SECTION(Database::Section::button_t::midiMessage, System::SYSEX_SECTION_RESET_BUTTON),
+        SYSEX_SECTION(Database::Section::button_t::midiID, 0),
+        SYSEX_SECTION(Database::Section::button_t::velocity, 0),
+        SYSEX_SECTION(Database::Section::button_t::midiChannel, System::SYSEX_SECTION_MIDI_CHANNEL),
+        SYSEX_SECTION(Database::Section::button_t::dualContactCurve, 0),
+        SYSEX_SECTION(Database::Section::button_t::debounceProfile, 0),
+        SYSEX_SECTION(Database::Section::button_t::debouncePressSamples, 0),
+        SYSEX_SECTION(Database::Section::button_t::debounceReleaseSamples, 0),
+        SYSEX_SECTION(Database::Section::button_t::gestureLongPressTime, System::SYSEX_SECTION_RESET_BUTTON),
+        SYSEX_SECTION(Database::Section::button_t::gestureDoubleTapTime, System::SYSEX_SECTION_RESET_BUTTON),
+        SYSEX_SECTION(Database::Section::button_t::gestureRepeatTime, System::SYSEX_SECTION_RESET_BUTTON),
+        SYSEX_SECTION(Database::Section::button_t::gestureMidiID, 0),
+    };
+
+    constexpr System::sysExSection_t encoderSectionMap[] = {
+        SYSEX_SECTION(Database::Section::encoder_t::enable, System::SYSEX_SECTION_RESET_ENCODER),
+        SYSEX_SECTION(Database::Section::encoder_t::invert, System::SYSEX_SECTION_RESET_ENCODER),
+        SYSEX_SECTION(Database::Section::encoder_t::mode, System::SYSEX_SECTION_RESET_ENCODER),
+        SYSEX_SECTION(Database::Section::encoder_t::midiID, System::SYSEX_SECTION_RESET_ENCODER),
+        SYSEX_SECTION(Database::Section::encoder_t::midiChannel, System::SYSEX_SECTION_RESET_ENCODER | System::SYSEX_SECTION_MIDI_CHANNEL),
+        SYSEX_SECTION(Database::Section::encoder_t::pulsesPerStep, System::SYSEX_SECTION_RESET_ENCODER),
+        SYSEX_SECTION(Database::Section::encoder_t::acceleration, System::SYSEX_SECTION_RESET_ENCODER),
+        SYSEX_SECTION(Database::Section::encoder_t::midiID, System::SYSEX_SECTION_NOT_SUPPORTED),
+        SYSEX_SECTION(Database::Section::encoder_t::remoteSync, System::SYSEX_SECTION_RESET_ENCODER),
+        SYSEX_SECTION(Database::Section::encoder_t::accelerationCurve, 0),
+    };
+
+    constexpr System::sysExSection_t analogSectionMap[] = {
+        SYSEX_SECTION(Database::Section::analog_t::enable, 0),
+        SYSEX_SECTION(Database::Section::analog_t::invert, 0),
+        SYSEX_SECTION(Database::Section::analog_t::type, System::SYSEX_SECTION_RESET_ANALOG),
+        SYSEX_SECTION(Database::Section::analog_t::midiID, 0),
+        SYSEX_SECTION(Database::Section::analog_t::midiID, System::SYSEX_SECTION_NOT_SUPPORTED),
+        SYSEX_SECTION(Database::Section::analog_t::lowerLimit, 0),
+        SYSEX_SECTION(Database::Section::analog_t::lowerLimit, System::SYSEX_SECTION_NOT_SUPPORTED),
+        SYSEX_SECTION(Database::Section::analog_t::upperLimit, 0),
+        SYSEX_SECTION(Database::Section::analog_t::upperLimit, System::SYSEX_SECTION_NOT_SUPPORTED),
+        SYSEX_SECTION(Database::Section::analog_t::midiChannel, System::SYSEX_SECTION_MIDI_CHANNEL),
+    };
+
+    constexpr System::sysExSection_t ledSectionMap[] = {
+        SYSEX_SECTION(Database::Section::leds_t::AMOUNT, System::SYSEX_SECTION_CUSTOM_GET | System::SYSEX_SECTION_CUSTOM_SET),    //not in db
+        SYSEX_SECTION(Database::Section::leds_t::AMOUNT, System::SYSEX_SECTION_CUSTOM_GET | System::SYSEX_SECTION_CUSTOM_SET),    //not in db
+        SYSEX_SECTION(Database::Section::leds_t::global, System::SYSEX_SECTION_CUSTOM_SET),
+        SYSEX_SECTION(Database::Section::leds_t::activationID, System::SYSEX_SECTION_CUSTOM_SET),
+        SYSEX_SECTION(Database::Section::leds_t::rgbEnable, System::SYSEX_SECTION_CUSTOM_GET | System::SYSEX_SECTION_CUSTOM_SET),
+        SYSEX_SECTION(Database::Section::leds_t::controlType, System::SYSEX_SECTION_CUSTOM_SET),
+        SYSEX_SECTION(Database::Section::leds_t::activationValue, 0),
+        SYSEX_SECTION(Database::Section::leds_t::midiChannel, System::SYSEX_SECTION_CUSTOM_SET | System::SYSEX_SECTION_MIDI_CHANNEL),
+    };
+
+    constexpr System::sysExSection_t displaySectionMap[] = {
+        SYSEX_SECTION(Database::Section::display_t::features, System::SYSEX_SECTION_CUSTOM_SET),
+        SYSEX_SECTION(Database::Section::display_t::setting, System::SYSEX_SECTION_CUSTOM_SET),
+    };
+
+    constexpr System::sysExSection_t touchscreenSectionMap[] = {
+        SYSEX_SECTION(Database::Section::touchscreen_t::setting, System::SYSEX_SECTION_CUSTOM_GET | System::SYSEX_SECTION_CUSTOM_SET),
+        SYSEX_SECTION(Database::Section::touchscreen_t::xPos, 0),
+        SYSEX_SECTION(Database::Section::touchscreen_t::yPos, 0),
+        SYSEX_SECTION(Database::Section::touchscreen_t::width, 0),
+        SYSEX_SECTION(Database::Section::touchscreen_t::height, 0),
+        SYSEX_SECTION(Database::Section::touchscreen_t::onScreen, 0),
+        SYSEX_SECTION(Database::Section::touchscreen_t::offScreen, 0),
+        SYSEX_SECTION(Database::Section::touchscreen_t::pageSwitchEnabled, 0),
+        SYSEX_SECTION(Database::Section::touchscreen_t::pageSwitchIndex, 0),
+        SYSEX_SECTION(Database::Section::touchscreen_t::analogPage, 0),
+        SYSEX_SECTION(Database::Section::touchscreen_t::analogStartXCoordinate, 0),
+        SYSEX_SECTION(Database::Section::touchscreen_t::analogEndXCoordinate, 0),
+        SYSEX_SECTION(Database::Section::touchscreen_t::analogStartYCoordinate, 0),
+        SYSEX_SECTION(Database::Section::touchscreen_t::analogEndYCoordinate, 0),
+        SYSEX_SECTION(Database::Section::touchscreen_t::analogType, 0),
+        SYSEX_SECTION(Database::Section::touchscreen_t::analogResetOnRelease, 0),
+    };
+
+    static_assert(sizeof(globalSectionMap) / sizeof(System::sysExSection_t) == static_cast<uint8_t>(System::Section::global_t::AMOUNT), "Invalid global section map");
+    static_assert(sizeof(buttonSectionMap) / sizeof(System::sysExSection_t) == static_cast<uint8_t>(System::Section::button_t::AMOUNT), "Invalid button section map");
+    static_assert(sizeof(encoderSectionMap) / sizeof(System::sysExSection_t) == static_cast<uint8_t>(System::Section::encoder_t::AMOUNT), "Invalid encoder section map");
+    static_assert(sizeof(analogSectionMap) / sizeof(System::sysExSection_t) == static_cast<uint8_t>(System::Section::analog_t::AMOUNT), "Invalid analog section map");
+    static_assert(sizeof(ledSectionMap) / sizeof(System::sysExSection_t) == static_cast<uint8_t>(System::Section::leds_t::AMOUNT), "Invalid LED section map");
+    static_assert(sizeof(displaySectionMap) / sizeof(System::sysExSection_t) == static_cast<uint8_t>(System::Section::display_t::AMOUNT), "Invalid display section map");
+    static_assert(sizeof(touchscreenSectionMap) / sizeof(System::sysExSection_t) == static_cast<uint8_t>(System::Section::touchscreen_t::AMOUNT), "Invalid touchscreen section map");
+
+    //indexed with System::block_t
+    constexpr System::sysExBlock_t blockMap[static_cast<uint8_t>(System::block_t::AMOUNT)] = {
+        { Database::block_t::global, globalSectionMap, static_cast<uint8_t>(System::Section::global_t::AMOUNT) },
+        { Database::block_t::buttons, buttonSectionMap, static_cast<uint8_t>(System::Section::button_t::AMOUNT) },
+        { Database::block_t::encoders, encoderSectionMap, static_cast<uint8_t>(System::Section::encoder_t::AMOUNT) },
+        { Database::block_t::analog, analogSectionMap, static_cast<uint8_t>(System::Section::analog_t::AMOUNT) },
+        { Database::block_t::leds, ledSectionMap, static_cast<uint8_t>(System::Section::leds_t::AMOUNT) },
+        { Database::block_t::display, displaySectionMap, static_cast<uint8_t>(System::Section::display_t::AMOUNT) },
+        { Database::block_t::touchscreen, touchscreenSectionMap, static_cast<uint8_t>(System::Section::touchscreen_t::AMOUNT) },
+    };
+}    // namespace
+
+#undef SYSEX_SECTION
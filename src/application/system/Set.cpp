@@ -24,58 +24,67 @@ uint8_t System::SysExDataHandler::set(uint8_t  block,
                                       uint16_t index,
                                       uint16_t newValue)
 {
-    auto sysExBlock = static_cast<block_t>(block);
-    auto result     = static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
+    return _system.onSet(block, section, index, newValue);
+}
 
-    switch (sysExBlock)
-    {
-    case block_t::global:
-    {
-        result = _system.onSetGlobal(static_cast<Section::global_t>(section), index, newValue);
-    }
-    break;
+uint8_t System::onSet(uint8_t block, uint8_t section, size_t index, uint16_t newValue)
+{
+    auto descriptor = sysExSection(block, section);
 
-    case block_t::buttons:
-    {
-        result = _system.onSetButtons(static_cast<Section::button_t>(section), index, newValue);
-    }
-    break;
+    if (descriptor == nullptr)
+        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
 
-    case block_t::encoders:
+    auto result = checkBlockAccess(static_cast<block_t>(block));
+
+    if (result != SysExConf::DataHandler::STATUS_OK)
+        return result;
+
+    if (descriptor->flags & SYSEX_SECTION_NOT_SUPPORTED)
+        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
+
+    //channels start from 0 in db, start from 1 in sysex
+    if (descriptor->flags & SYSEX_SECTION_MIDI_CHANNEL)
+        newValue--;
+
+    if (descriptor->flags & SYSEX_SECTION_CUSTOM_SET)
+        result = onSetCustom(static_cast<block_t>(block), section, index, newValue);
+    else
+        result = _database.update(static_cast<uint8_t>(dbBlock(block)), descriptor->dbSection, index, newValue) ? SysExConf::DataHandler::STATUS_OK : SysExConf::DataHandler::STATUS_ERROR_RW;
+
+    if (result == SysExConf::DataHandler::STATUS_OK)
     {
-        result = _system.onSetEncoders(static_cast<Section::encoder_t>(section), index, newValue);
+        if (descriptor->flags & SYSEX_SECTION_RESET_BUTTON)
+            _buttons.reset(index);
+
+        if (descriptor->flags & SYSEX_SECTION_RESET_ENCODER)
+            _encoders.resetValue(index);
+
+        if (descriptor->flags & SYSEX_SECTION_RESET_ANALOG)
+            _analog.debounceReset(index);
     }
-    break;
 
-    case block_t::analog:
+    return result;
+}
+
+uint8_t System::onSetCustom(block_t block, uint8_t section, size_t index, uint16_t newValue)
+{
+    switch (block)
     {
-        result = _system.onSetAnalog(static_cast<Section::analog_t>(section), index, newValue);
-    }
-    break;
+    case block_t::global:
+        return onSetGlobal(static_cast<Section::global_t>(section), index, newValue);
 
     case block_t::leds:
-    {
-        result = _system.onSetLEDs(static_cast<Section::leds_t>(section), index, newValue);
-    }
-    break;
+        return onSetLEDs(static_cast<Section::leds_t>(section), index, newValue);
 
     case block_t::display:
-    {
-        result = _system.onSetDisplay(static_cast<Section::display_t>(section), index, newValue);
-    }
-    break;
+        return onSetDisplay(static_cast<Section::display_t>(section), index, newValue);
 
     case block_t::touchscreen:
-    {
-        result = _system.onSetTouchscreen(static_cast<Section::touchscreen_t>(section), index, newValue);
-    }
-    break;
+        return onSetTouchscreen(static_cast<Section::touchscreen_t>(section), index, newValue);
 
     default:
-        break;
+        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
     }
-
-    return result;
 }
 
 uint8_t System::onSetGlobal(Section::global_t section, size_t index, uint16_t newValue)
@@ -347,92 +356,8 @@ uint8_t System::onSetGlobal(Section::global_t section, size_t index, uint16_t ne
     return result;
 }
 
-uint8_t System::onSetButtons(Section::button_t section, size_t index, uint16_t newValue)
-{
-    if (!_hwa.io().buttons().supported())
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
-    uint8_t result = SysExConf::DataHandler::STATUS_ERROR_RW;
-
-    //channels start from 0 in db, start from 1 in sysex
-    if (section == Section::button_t::midiChannel)
-        newValue--;
-
-    result = _database.update(dbSection(section), index, newValue) ? SysExConf::DataHandler::STATUS_OK : SysExConf::DataHandler::STATUS_ERROR_RW;
-
-    if (result == SysExConf::DataHandler::STATUS_OK)
-    {
-        if (
-            (section == Section::button_t::type) ||
-            (section == Section::button_t::midiMessage))
-            _buttons.reset(index);
-    }
-
-    return result;
-}
-
-uint8_t System::onSetEncoders(Section::encoder_t section, size_t index, uint16_t newValue)
-{
-    if (!_hwa.io().encoders().supported())
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
-    switch (section)
-    {
-    case Section::encoder_t::midiID_MSB:
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
-    default:
-    {
-        //channels start from 0 in db, start from 1 in sysex
-        if (section == Section::encoder_t::midiChannel)
-            newValue--;
-    }
-    break;
-    }
-
-    auto result = _database.update(dbSection(section), index, newValue) ? SysExConf::DataHandler::STATUS_OK : SysExConf::DataHandler::STATUS_ERROR_RW;
-
-    if (result == SysExConf::DataHandler::STATUS_OK)
-        _encoders.resetValue(index);
-
-    return result;
-}
-
-uint8_t System::onSetAnalog(Section::analog_t section, size_t index, uint16_t newValue)
-{
-    if (!_hwa.io().analog().supported())
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
-    switch (section)
-    {
-    case Section::analog_t::midiID_MSB:
-    case Section::analog_t::lowerLimit_MSB:
-    case Section::analog_t::upperLimit_MSB:
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
-    case Section::analog_t::type:
-    {
-        _analog.debounceReset(index);
-    }
-    break;
-
-    default:
-    {
-        //channels start from 0 in db, start from 1 in sysex
-        if (section == Section::analog_t::midiChannel)
-            newValue--;
-    }
-    break;
-    }
-
-    return _database.update(dbSection(section), index, newValue) ? SysExConf::DataHandler::STATUS_OK : SysExConf::DataHandler::STATUS_ERROR_RW;
-}
-
 uint8_t System::onSetLEDs(Section::leds_t section, size_t index, uint16_t newValue)
 {
-    if (!_hwa.io().leds().supported())
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
     uint8_t result = SysExConf::DataHandler::STATUS_ERROR_RW;
 
     bool writeToDb = true;
@@ -547,10 +472,6 @@ uint8_t System::onSetLEDs(Section::leds_t section, size_t index, uint16_t newVal
     case Section::leds_t::controlType:
     case Section::leds_t::midiChannel:
     {
-        //channels start from 0 in db, start from 1 in sysex
-        if (section == Section::leds_t::midiChannel)
-            newValue--;
-
         //first, find out if RGB led is enabled for this led index
         if (_database.read(dbSection(Section::leds_t::rgbEnable), _leds.rgbIndex(index)))
         {
@@ -582,14 +503,15 @@ uint8_t System::onSetLEDs(Section::leds_t section, size_t index, uint16_t newVal
     break;
     }
 
+    //leds need to reload settings used to find the leds matching incoming messages
+    if ((section == Section::leds_t::activationID) || (section == Section::leds_t::controlType) || (section == Section::leds_t::rgbEnable))
+        _leds.init(false);
+
     return result;
 }
 
 uint8_t System::onSetDisplay(Section::display_t section, size_t index, uint16_t newValue)
 {
-    if (!_hwa.io().display().supported())
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
-
     auto initAction = initAction_t::asIs;
 
     switch (section)
@@ -682,93 +604,83 @@ uint8_t System::onSetDisplay(Section::display_t section, size_t index, uint16_t
 
 uint8_t System::onSetTouchscreen(Section::touchscreen_t section, size_t index, uint16_t newValue)
 {
-    if (!_hwa.io().touchscreen().supported())
-        return static_cast<uint8_t>(SysExConf::status_t::errorNotSupported);
+    auto initAction = initAction_t::asIs;
+    auto mode       = IO::Touchscreen::mode_t::normal;
+    bool writeToDb  = true;
 
-    if (!_touchscreen.isInitialized() && _hwa.serialPeripheralAllocated(serialPeripheral_t::touchscreen) && _backupRestoreState != backupRestoreState_t::none)
+    switch (section)
     {
-        return SERIAL_PERIPHERAL_ALLOCATED_ERROR;
-    }
-    else
+    case Section::touchscreen_t::setting:
     {
-        auto initAction = initAction_t::asIs;
-        auto mode       = IO::Touchscreen::mode_t::normal;
-        bool writeToDb  = true;
-
-        switch (section)
+        switch (index)
         {
-        case Section::touchscreen_t::setting:
+        case static_cast<size_t>(IO::Touchscreen::setting_t::enable):
         {
-            switch (index)
-            {
-            case static_cast<size_t>(IO::Touchscreen::setting_t::enable):
-            {
-                if (newValue)
-                    initAction = initAction_t::init;
-                else
-                    initAction = initAction_t::deInit;
-            }
-            break;
-
-            case static_cast<size_t>(IO::Touchscreen::setting_t::model):
-            {
+            if (newValue)
                 initAction = initAction_t::init;
-            }
-            break;
+            else
+                initAction = initAction_t::deInit;
+        }
+        break;
+
+        case static_cast<size_t>(IO::Touchscreen::setting_t::model):
+        {
+            initAction = initAction_t::init;
+        }
+        break;
 
-            case static_cast<size_t>(IO::Touchscreen::setting_t::brightness):
+        case static_cast<size_t>(IO::Touchscreen::setting_t::brightness):
+        {
+            if (_touchscreen.isInitialized())
             {
-                if (_touchscreen.isInitialized())
-                {
-                    if (!_touchscreen.setBrightness(static_cast<IO::Touchscreen::brightness_t>(newValue)))
-                        return SysExConf::DataHandler::STATUS_ERROR_RW;
-                }
+                if (!_touchscreen.setBrightness(static_cast<IO::Touchscreen::brightness_t>(newValue)))
+                    return SysExConf::DataHandler::STATUS_ERROR_RW;
             }
-            break;
+        }
+        break;
 
-            case static_cast<size_t>(IO::Touchscreen::setting_t::cdcPassthrough):
+        case static_cast<size_t>(IO::Touchscreen::setting_t::cdcPassthrough):
+        {
+            if (_database.read(Database::Section::global_t::dmx, dmxSetting_t::enabled))
             {
-                if (_database.read(Database::Section::global_t::dmx, dmxSetting_t::enabled))
+                if (_backupRestoreState != backupRestoreState_t::none)
                 {
-                    if (_backupRestoreState != backupRestoreState_t::none)
-                    {
-                        return CDC_ALLOCATED_ERROR;
-                    }
+                    return CDC_ALLOCATED_ERROR;
                 }
-
-                mode       = IO::Touchscreen::mode_t::cdcPassthrough;
-                initAction = newValue ? initAction_t::init : initAction_t::deInit;
-                writeToDb  = false;
             }
-            break;
 
-            default:
-                break;
-            }
+            mode       = IO::Touchscreen::mode_t::cdcPassthrough;
+            initAction = newValue ? initAction_t::init : initAction_t::deInit;
+            writeToDb  = false;
         }
         break;
 
         default:
             break;
         }
+    }
+    break;
+
+    default:
+        break;
+    }
 
-        bool result = true;
+    bool result = true;
 
-        if (writeToDb)
-            result = _database.update(dbSection(section), index, newValue);
+    if (writeToDb)
+        result = _database.update(dbSection(section), index, newValue);
 
-        if (result)
-        {
-            if (initAction == initAction_t::init)
-                _touchscreen.init(mode);
-            else if (initAction == initAction_t::deInit)
-                _touchscreen.deInit(mode);
+    if (result)
+    {
+        if (initAction == initAction_t::init)
+            _touchscreen.init(mode);
+        else if (initAction == initAction_t::deInit)
+            _touchscreen.deInit(mode);
 
-            return SysExConf::DataHandler::STATUS_OK;
-        }
-        else
-        {
-            return SysExConf::DataHandler::STATUS_ERROR_RW;
-        }
+        return SysExConf::DataHandler::STATUS_OK;
+    }
+    else
+    {
+        return SysExConf::DataHandler::STATUS_ERROR_RW;
     }
 }
\ No newline at end of file
@@ -127,6 +127,34 @@ uint8_t System::SysExDataHandler::customRequest(uint16_t request, CustomResponse
     }
     break;
 
+    case SYSEX_CR_PRESET_DUMP:
+    {
+        //dump is sent once this request is acknowledged
+        _system._presetDumpRequested = true;
+    }
+    break;
+
+    case SYSEX_CR_INPUT_SCAN_TIME:
+    {
+        inputScanTime_t scanTime;
+
+        if (_system._hwa.inputScanTime(scanTime))
+        {
+            const uint32_t values[] = { scanTime.period, scanTime.last, scanTime.max };
+
+            for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+            {
+                customResponse.append((values[i] >> 14) & 0x3FFF);
+                customResponse.append(values[i] & 0x3FFF);
+            }
+        }
+        else
+        {
+            result = SysExConf::DataHandler::STATUS_ERROR_RW;
+        }
+    }
+    break;
+
     default:
     {
         result = SysExConf::DataHandler::STATUS_ERROR_RW;
@@ -137,9 +165,16 @@ uint8_t System::SysExDataHandler::customRequest(uint16_t request, CustomResponse
     return result;
 }
 
+void System::DBhandlers::presetChangeStart(uint8_t preset)
+{
+    //values which are waiting to be stored belong to the preset which is being left
+    _system._encoders.storeValues();
+}
+
 void System::DBhandlers::presetChange(uint8_t preset)
 {
     _system._leds.setAllOff();
+    _system._leds.init(false);
 
     if (_system._backupRestoreState == backupRestoreState_t::none)
     {
@@ -378,6 +413,120 @@ void System::backup()
     _backupRestoreState = backupRestoreState_t::none;
 }
 
+/// Processes bulk get/set request for a run of parameters in single block and section.
+/// param [in]: array   Received SysEx message.
+/// param [in]: size    Size of received message.
+/// returns: True if the message was bulk request (even invalid), false otherwise.
+bool System::handleBulkRequest(const uint8_t* array, size_t size)
+{
+    if (size < (BULK_HEADER_SIZE + 1))
+        return false;
+
+    if ((array[1] != _sysExMID.id1) || (array[2] != _sysExMID.id2) || (array[3] != _sysExMID.id3))
+        return false;
+
+    if ((array[4] != static_cast<uint8_t>(SysExConf::status_t::request)) || (array[5] != 0))
+        return false;
+
+    if ((array[6] != SYSEX_CR_BULK_GET) && (array[6] != SYSEX_CR_BULK_SET))
+        return false;
+
+    const bool     set        = array[6] == SYSEX_CR_BULK_SET;
+    const uint8_t  block      = array[7];
+    const uint8_t  section    = array[8];
+    const uint16_t startIndex = (array[9] << 7) | array[10];
+    const uint8_t  count      = array[11];
+
+    uint8_t response[BULK_HEADER_SIZE + (BULK_MAX_PARAMETERS * 2) + 1];
+    size_t  responseSize = BULK_HEADER_SIZE;
+    uint8_t processed    = 0;
+    uint8_t status       = static_cast<uint8_t>(SysExConf::status_t::ack);
+
+    for (size_t i = 0; i < BULK_HEADER_SIZE; i++)
+        response[i] = array[i];
+
+    if (!_sysExConf.isConfigurationEnabled())
+    {
+        status = static_cast<uint8_t>(SysExConf::status_t::errorConnection);
+    }
+    else if (!count || (count > BULK_MAX_PARAMETERS) || (size != (BULK_HEADER_SIZE + (set ? (count * 2) : 0) + 1)))
+    {
+        status = static_cast<uint8_t>(SysExConf::status_t::errorMessageLength);
+    }
+    else if (block >= sysExLayout.size())
+    {
+        status = static_cast<uint8_t>(SysExConf::status_t::errorBlock);
+    }
+    else if (section >= sysExLayout[block].section.size())
+    {
+        status = static_cast<uint8_t>(SysExConf::status_t::errorSection);
+    }
+    else if ((startIndex + count) > sysExLayout[block].section[section].numberOfParameters)
+    {
+        status = static_cast<uint8_t>(SysExConf::status_t::errorIndex);
+    }
+    else
+    {
+        const auto& layout = sysExLayout[block].section[section];
+
+        for (; processed < count; processed++)
+        {
+            uint16_t value  = 0;
+            uint8_t  result = SysExConf::DataHandler::STATUS_OK;
+
+            if (set)
+            {
+                value = (array[BULK_HEADER_SIZE + (processed * 2)] << 7) | array[BULK_HEADER_SIZE + (processed * 2) + 1];
+
+                //no range check if both limits are zero
+                if ((layout.newValueMin || layout.newValueMax) && ((value < layout.newValueMin) || (value > layout.newValueMax)))
+                {
+                    status = static_cast<uint8_t>(SysExConf::status_t::errorNewValue);
+                    break;
+                }
+
+                result = onSet(block, section, startIndex + processed, value);
+            }
+            else
+            {
+                result = onGet(block, section, startIndex + processed, value);
+            }
+
+            if (result != SysExConf::DataHandler::STATUS_OK)
+            {
+                if (result == SysExConf::DataHandler::STATUS_ERROR_RW)
+                    status = static_cast<uint8_t>(set ? SysExConf::status_t::errorWrite : SysExConf::status_t::errorRead);
+                else
+                    status = result;
+
+                break;
+            }
+
+            if (!set)
+            {
+                SysExConf::split14bit(value, response[responseSize], response[responseSize + 1]);
+                responseSize += 2;
+            }
+        }
+    }
+
+    response[4] = status;
+
+    if (status != static_cast<uint8_t>(SysExConf::status_t::ack))
+    {
+        //report how many parameters were processed before the error and drop the values
+        response[11] = processed;
+        responseSize = BULK_HEADER_SIZE;
+    }
+
+    response[responseSize++] = 0xF7;
+
+    //never send responses through DIN MIDI
+    _midi.sendSysEx(responseSize, response, true, MIDI::interface_t::usb);
+
+    return true;
+}
+
 void System::checkComponents()
 {
     enum class componentCheck_t : uint8_t
@@ -456,10 +605,17 @@ void System::checkMIDI()
             //process sysex messages only from usb interface
             if (interface == MIDI::interface_t::usb)
             {
-                _sysExConf.handleMessage(_midi.getSysExArray(interface), _midi.getSysExArrayLength(interface));
+                auto sysExArray  = _midi.getSysExArray(interface);
+                auto sysExLength = _midi.getSysExArrayLength(interface);
+
+                if (!handleBulkRequest(sysExArray, sysExLength) && !handlePresetLoad(sysExArray, sysExLength))
+                    _sysExConf.handleMessage(sysExArray, sysExLength);
 
                 if (_backupRestoreState == backupRestoreState_t::backup)
                     backup();
+
+                if (_presetDumpRequested)
+                    presetDump();
             }
         }
         break;
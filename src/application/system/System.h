@@ -125,6 +125,14 @@ class System
             midiID,
             velocity,
             midiChannel,
+            dualContactCurve,
+            debounceProfile,
+            debouncePressSamples,
+            debounceReleaseSamples,
+            gestureLongPressTime,
+            gestureDoubleTapTime,
+            gestureRepeatTime,
+            gestureMidiID,
             AMOUNT
         };
 
@@ -139,6 +147,7 @@ class System
             acceleration,
             midiID_MSB,
             remoteSync,
+            accelerationCurve,
             AMOUNT
         };
 
@@ -202,10 +211,52 @@ class System
     using usbConnectionHandler_t = std::function<void()>;
     using uniqueID_t             = std::array<uint8_t, UID_BITS / 8>;
 
+    /// Timing of digital input scanning in nanoseconds: time between two scans and
+    /// durations of the last and of the longest scan since the previous read.
+    struct inputScanTime_t
+    {
+        uint32_t period;
+        uint32_t last;
+        uint32_t max;
+    };
+
     //time in milliseconds after which all internal MIDI values will be forcefully resent when scheduled
     //done after preset change or on usb connection state change
     static constexpr uint32_t FORCED_VALUE_RESEND_DELAY = 500;
 
+    /// Describes how single SysEx section maps to the database section and
+    /// which transformations and actions are needed when it is accessed.
+    struct sysExSection_t
+    {
+        uint8_t dbSection;
+        uint8_t flags;
+    };
+
+    /// Describes all sections of a single SysEx block.
+    struct sysExBlock_t
+    {
+        Database::block_t     dbBlock;
+        const sysExSection_t* sections;
+        uint8_t               numberOfSections;
+    };
+
+    //section isn't accessible over sysex (eg. MSB part of 14-bit values)
+    static constexpr uint8_t SYSEX_SECTION_NOT_SUPPORTED = 0x01;
+
+    //reading needs handling beyond plain database read
+    static constexpr uint8_t SYSEX_SECTION_CUSTOM_GET = 0x02;
+
+    //writing needs handling beyond plain database write
+    static constexpr uint8_t SYSEX_SECTION_CUSTOM_SET = 0x04;
+
+    //channels start from 0 in db, start from 1 in sysex
+    static constexpr uint8_t SYSEX_SECTION_MIDI_CHANNEL = 0x08;
+
+    //actions to perform once the value has been successfully written
+    static constexpr uint8_t SYSEX_SECTION_RESET_BUTTON  = 0x10;
+    static constexpr uint8_t SYSEX_SECTION_RESET_ENCODER = 0x20;
+    static constexpr uint8_t SYSEX_SECTION_RESET_ANALOG  = 0x40;
+
     class HWA
     {
         public:
@@ -231,16 +282,19 @@ class System
             class Buttons
             {
                 public:
-                virtual bool   supported()                                                      = 0;
-                virtual bool   state(size_t index, uint8_t& numberOfReadings, uint32_t& states) = 0;
-                virtual size_t buttonToEncoderIndex(size_t index)                               = 0;
+                virtual bool   supported()                                                                       = 0;
+                virtual bool   state(size_t index, uint8_t& numberOfReadings, uint32_t& states, bool& debounced) = 0;
+                virtual bool   changed(::IO::Buttons::changedBitmap_t& bitmap)                                   = 0;
+                virtual bool   edgeTime(size_t index, uint32_t& time)                                            = 0;
+                virtual size_t buttonToEncoderIndex(size_t index)                                                = 0;
             };
 
             class Encoders
             {
                 public:
-                virtual bool supported()                                                      = 0;
-                virtual bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) = 0;
+                virtual bool supported()                                      = 0;
+                virtual bool changed(::IO::Encoders::changedBitmap_t& bitmap) = 0;
+                virtual bool pulses(size_t index, int16_t& pulses)            = 0;
             };
 
             class Touchscreen
@@ -324,6 +378,7 @@ class System
         virtual void      registerOnUSBconnectionHandler(usbConnectionHandler_t&& usbConnectionHandler) = 0;
         virtual bool      serialPeripheralAllocated(serialPeripheral_t peripheral)                      = 0;
         virtual bool      uniqueID(uniqueID_t& uniqueID)                                                = 0;
+        virtual bool      inputScanTime(inputScanTime_t& scanTime)                                      = 0;
         virtual IO&       io()                                                                          = 0;
         virtual Protocol& protocol()                                                                    = 0;
     };
@@ -383,6 +438,7 @@ class System
             : _system(system)
         {}
 
+        void presetChangeStart(uint8_t preset) override;
         void presetChange(uint8_t preset) override;
         void factoryResetStart() override;
         void factoryResetDone() override;
@@ -442,7 +498,9 @@ class System
             : _system(system)
         {}
 
-        bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) override;
+        bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states, bool& debounced) override;
+        bool changed(IO::Buttons::changedBitmap_t& bitmap) override;
+        bool edgeTime(size_t index, uint32_t& time) override;
 
         private:
         System& _system;
@@ -455,7 +513,8 @@ class System
             : _system(system)
         {}
 
-        bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) override;
+        bool changed(IO::Encoders::changedBitmap_t& bitmap) override;
+        bool pulses(size_t index, int16_t& pulses) override;
 
         private:
         System& _system;
@@ -553,11 +612,17 @@ class System
     void                             checkComponents();
     void                             checkMIDI();
     void                             configureMIDI();
-    bool                             onGet(uint8_t block, uint8_t section, size_t index, uint16_t& value);
-    bool                             onSet(uint8_t block, uint8_t section, size_t index, uint16_t newValue);
-    bool                             onCustomRequest(size_t value);
-    void                             onWrite(uint8_t* sysExArray, size_t size);
+    uint8_t                          onGet(uint8_t block, uint8_t section, size_t index, uint16_t& value);
+    uint8_t                          onSet(uint8_t block, uint8_t section, size_t index, uint16_t newValue);
+    uint8_t                          onGetCustom(block_t block, uint8_t section, size_t index, uint16_t& value);
+    uint8_t                          onSetCustom(block_t block, uint8_t section, size_t index, uint16_t newValue);
+    uint8_t                          checkBlockAccess(block_t block);
+    const sysExSection_t*            sysExSection(uint8_t block, uint8_t section);
     void                             backup();
+    bool                             handleBulkRequest(const uint8_t* array, size_t size);
+    void                             presetDump();
+    bool                             handlePresetLoad(const uint8_t* array, size_t size);
+    uint8_t                          presetLoadChunk(const uint8_t* payload, size_t size);
     void                             forceComponentRefresh();
     Database::block_t                dbBlock(uint8_t index);
     Database::Section::global_t      dbSection(Section::global_t section);
@@ -568,16 +633,9 @@ class System
     Database::Section::display_t     dbSection(Section::display_t section);
     Database::Section::touchscreen_t dbSection(Section::touchscreen_t section);
     uint8_t                          onGetGlobal(Section::global_t section, size_t index, uint16_t& value);
-    uint8_t                          onGetButtons(Section::button_t section, size_t index, uint16_t& value);
-    uint8_t                          onGetEncoders(Section::encoder_t section, size_t index, uint16_t& value);
-    uint8_t                          onGetAnalog(Section::analog_t section, size_t index, uint16_t& value);
     uint8_t                          onGetLEDs(Section::leds_t section, size_t index, uint16_t& value);
-    uint8_t                          onGetDisplay(Section::display_t section, size_t index, uint16_t& value);
     uint8_t                          onGetTouchscreen(Section::touchscreen_t section, size_t index, uint16_t& value);
     uint8_t                          onSetGlobal(Section::global_t section, size_t index, uint16_t newValue);
-    uint8_t                          onSetButtons(Section::button_t section, size_t index, uint16_t newValue);
-    uint8_t                          onSetEncoders(Section::encoder_t section, size_t index, uint16_t newValue);
-    uint8_t                          onSetAnalog(Section::analog_t section, size_t index, uint16_t newValue);
     uint8_t                          onSetLEDs(Section::leds_t section, size_t index, uint16_t newValue);
     uint8_t                          onSetDisplay(Section::display_t section, size_t index, uint16_t newValue);
     uint8_t                          onSetTouchscreen(Section::touchscreen_t section, size_t index, uint16_t newValue);
@@ -608,7 +666,7 @@ class System
     IO::LEDs                _leds         = IO::LEDs(_hwaLEDs, _database, _dispatcher);
     IO::Analog              _analog       = IO::Analog(_hwaAnalog, _analogFilter, _database, _dispatcher);
     IO::Buttons             _buttons      = IO::Buttons(_hwaButtons, _buttonsFilter, _database, _dispatcher);
-    IO::Encoders            _encoders     = IO::Encoders(_hwaEncoders, _encodersFilter, 1, _database, _dispatcher);
+    IO::Encoders            _encoders     = IO::Encoders(_hwaEncoders, _encodersFilter, _database, _dispatcher);
     IO::Touchscreen         _touchscreen  = IO::Touchscreen(_hwaTouchscreen, _database, _hwaCDCPassthrough);
     IO::U8X8                _u8x8         = IO::U8X8(_hwaU8X8);
     IO::Display             _display      = IO::Display(_u8x8, _database, _dispatcher);
@@ -622,88 +680,41 @@ class System
     static constexpr uint8_t SERIAL_PERIPHERAL_ALLOCATED_ERROR = 80;
     static constexpr uint8_t CDC_ALLOCATED_ERROR               = 81;
 
-    enum class backupRestoreState_t : uint8_t
-    {
-        none,
-        backup,
-        restore
-    };
+    //F0, manufacturer ID, status, part, request, block, section, index (2 bytes), count
+    static constexpr size_t BULK_HEADER_SIZE = 12;
 
-    backupRestoreState_t _backupRestoreState = backupRestoreState_t::none;
+    //limit the amount of parameters so that the message fits into midi sysex buffer
+    static constexpr size_t BULK_MAX_PARAMETERS = (MIDI_SYSEX_ARRAY_SIZE - BULK_HEADER_SIZE - 1) / 2;
 
-    //map sysex sections to sections in db
-    const Database::Section::global_t _sysEx2DB_global[static_cast<uint8_t>(Section::global_t::AMOUNT)] = {
-        Database::Section::global_t::midiFeatures,
-        Database::Section::global_t::midiMerge,
-        Database::Section::global_t::AMOUNT,    //unused
-        Database::Section::global_t::dmx,
-    };
+    //F0, manufacturer ID, status, part, request
+    static constexpr size_t PRESET_HEADER_SIZE = 7;
 
-    const Database::Section::button_t _sysEx2DB_button[static_cast<uint8_t>(Section::button_t::AMOUNT)] = {
-        Database::Section::button_t::type,
-        Database::Section::button_t::midiMessage,
-        Database::Section::button_t::midiID,
-        Database::Section::button_t::velocity,
-        Database::Section::button_t::midiChannel
-    };
+    //chunks sent in preset dump must fit into sysex buffer once they're sent back for loading
+    static constexpr size_t PRESET_CHUNK_SIZE = MIDI_SYSEX_ARRAY_SIZE - PRESET_HEADER_SIZE - 1;
 
-    const Database::Section::encoder_t _sysEx2DB_encoder[static_cast<uint8_t>(Section::encoder_t::AMOUNT)] = {
-        Database::Section::encoder_t::enable,
-        Database::Section::encoder_t::invert,
-        Database::Section::encoder_t::mode,
-        Database::Section::encoder_t::midiID,
-        Database::Section::encoder_t::midiChannel,
-        Database::Section::encoder_t::pulsesPerStep,
-        Database::Section::encoder_t::acceleration,
-        Database::Section::encoder_t::midiID,
-        Database::Section::encoder_t::remoteSync
-    };
+    //each record has a header byte: bit 6 set marks the run of identical values,
+    //while the lower 6 bits hold the amount of values in record minus one
+    static constexpr uint8_t PRESET_RECORD_RUN       = 0x40;
+    static constexpr uint8_t PRESET_RECORD_MAX_COUNT = 64;
 
-    const Database::Section::analog_t _sysEx2DB_analog[static_cast<uint8_t>(Section::analog_t::AMOUNT)] = {
-        Database::Section::analog_t::enable,
-        Database::Section::analog_t::invert,
-        Database::Section::analog_t::type,
-        Database::Section::analog_t::midiID,
-        Database::Section::analog_t::midiID,
-        Database::Section::analog_t::lowerLimit,
-        Database::Section::analog_t::lowerLimit,
-        Database::Section::analog_t::upperLimit,
-        Database::Section::analog_t::upperLimit,
-        Database::Section::analog_t::midiChannel
-    };
+    //parameters are up to 16-bit wide so every value is split into three 7-bit bytes
+    static constexpr uint8_t PRESET_VALUE_SIZE = 3;
 
-    const Database::Section::leds_t _sysEx2DB_leds[static_cast<uint8_t>(Section::leds_t::AMOUNT)] = {
-        Database::Section::leds_t::AMOUNT,
-        Database::Section::leds_t::AMOUNT,
-        Database::Section::leds_t::global,
-        Database::Section::leds_t::activationID,
-        Database::Section::leds_t::rgbEnable,
-        Database::Section::leds_t::controlType,
-        Database::Section::leds_t::activationValue,
-        Database::Section::leds_t::midiChannel,
-    };
+    //literal record needs to fit into single chunk
+    static constexpr uint8_t PRESET_MAX_LITERALS = ((PRESET_CHUNK_SIZE - 1) / PRESET_VALUE_SIZE) < PRESET_RECORD_MAX_COUNT ? ((PRESET_CHUNK_SIZE - 1) / PRESET_VALUE_SIZE) : PRESET_RECORD_MAX_COUNT;
 
-    const Database::Section::display_t _sysEx2DB_display[static_cast<uint8_t>(Section::display_t::AMOUNT)] = {
-        Database::Section::display_t::features,
-        Database::Section::display_t::setting,
+    enum class backupRestoreState_t : uint8_t
+    {
+        none,
+        backup,
+        restore
     };
 
-    const Database::Section::touchscreen_t _sysEx2DB_touchscreen[static_cast<uint8_t>(Section::touchscreen_t::AMOUNT)] = {
-        Database::Section::touchscreen_t::setting,
-        Database::Section::touchscreen_t::xPos,
-        Database::Section::touchscreen_t::yPos,
-        Database::Section::touchscreen_t::width,
-        Database::Section::touchscreen_t::height,
-        Database::Section::touchscreen_t::onScreen,
-        Database::Section::touchscreen_t::offScreen,
-        Database::Section::touchscreen_t::pageSwitchEnabled,
-        Database::Section::touchscreen_t::pageSwitchIndex,
-        Database::Section::touchscreen_t::analogPage,
-        Database::Section::touchscreen_t::analogStartXCoordinate,
-        Database::Section::touchscreen_t::analogEndXCoordinate,
-        Database::Section::touchscreen_t::analogStartYCoordinate,
-        Database::Section::touchscreen_t::analogEndYCoordinate,
-        Database::Section::touchscreen_t::analogType,
-        Database::Section::touchscreen_t::analogResetOnRelease,
-    };
+    backupRestoreState_t _backupRestoreState = backupRestoreState_t::none;
+
+    bool                        _presetDumpRequested = false;
+    bool                        _presetLoadActive    = false;
+    bool                        _presetLoadRemaining = false;
+    uint32_t                    _presetLoadCount     = 0;
+    Database::parameterCursor_t _presetLoadCursor;
 };
\ No newline at end of file
@@ -18,11 +18,21 @@ limitations under the License.
 
 #include "system/System.h"
 
-bool System::HWAButtons::state(size_t index, uint8_t& numberOfReadings, uint32_t& states)
+bool System::HWAButtons::state(size_t index, uint8_t& numberOfReadings, uint32_t& states, bool& debounced)
 {
     //if encoder under this index is enabled, just return false state each time
     if (_system._database.read(Database::Section::encoder_t::enable, _system._hwa.io().buttons().buttonToEncoderIndex(index)))
         return false;
 
-    return _system._hwa.io().buttons().state(index, numberOfReadings, states);
+    return _system._hwa.io().buttons().state(index, numberOfReadings, states, debounced);
+}
+
+bool System::HWAButtons::changed(IO::Buttons::changedBitmap_t& bitmap)
+{
+    return _system._hwa.io().buttons().changed(bitmap);
+}
+
+bool System::HWAButtons::edgeTime(size_t index, uint32_t& time)
+{
+    return _system._hwa.io().buttons().edgeTime(index, time);
 }
\ No newline at end of file
@@ -18,7 +18,12 @@ limitations under the License.
 
 #include "system/System.h"
 
-bool System::HWAEncoders::state(size_t index, uint8_t& numberOfReadings, uint32_t& states)
+bool System::HWAEncoders::changed(IO::Encoders::changedBitmap_t& bitmap)
 {
-    return _system._hwa.io().encoders().state(index, numberOfReadings, states);
-}
\ No newline at end of file
+    return _system._hwa.io().encoders().changed(bitmap);
+}
+
+bool System::HWAEncoders::pulses(size_t index, int16_t& pulses)
+{
+    return _system._hwa.io().encoders().pulses(index, pulses);
+}
@@ -261,12 +261,28 @@ namespace Board
         /// Count represents total amount of readings stored in readings variable.
         /// Readings variable contains up to last 32 readings where LSB bit is the
         /// newest reading, and MSB bit is the last.
+        /// Debounced variable contains the state of input after debouncing all
+        /// the readings sampled so far.
         typedef struct
         {
             uint8_t  count;
             uint32_t readings;
+            bool     debounced;
         } dInReadings_t;
 
+        /// Structure holding the timing of digital input scanning. All values are in nanoseconds.
+        /// Period is the time between two scans, last and max are durations of the last
+        /// and of the longest scan.
+        struct dInScanTime_t
+        {
+            uint32_t period;
+            uint32_t last;
+            uint32_t max;
+        };
+
+        /// Bitmap holding single bit for every digital input.
+        using dInBitmap_t = std::array<uint32_t, (MAX_NUMBER_OF_BUTTONS + 31) / 32 ? (MAX_NUMBER_OF_BUTTONS + 31) / 32 : 1>;
+
         enum class dataSource_t : uint8_t
         {
             usb,
@@ -280,11 +296,36 @@ namespace Board
         };
 
         /// Returns last read digital input states for requested digital input index.
+        /// Debounced state is taken from the snapshot of all digital inputs made in digitalInChanged,
+        /// readings are the latest ones.
         /// param [in]:     digitalInIndex  Index of digital input which should be read.
         /// param [in,out]: dInReadings     Reference to variable in which new digital input readings are stored.
         /// returns: True if there are new readings for specified digital input index.
         bool digitalInState(size_t digitalInIndex, dInReadings_t& dInReadings);
 
+        /// Retrieves the bitmap of digital inputs which have changed since the last call and clears it.
+        /// Digital input is considered changed if its raw reading or its debounced state has changed.
+        /// Consistent snapshot of all digital inputs is taken without disabling interrupts and
+        /// used for all subsequent reads until the next call. Snapshot is taken only if some
+        /// digital input has changed since the last call.
+        /// param [in,out]: changed Reference to bitmap in which bits of changed digital input indexes are set.
+        /// returns: True if at least one digital input has changed, false otherwise.
+        bool digitalInChanged(dInBitmap_t& changed);
+
+        /// Retrieves the time at which the debounced state of digital input has last changed.
+        /// Time is captured when the input is sampled so it has the resolution of single sampling period.
+        /// param [in]:     digitalInIndex  Index of digital input for which to retrieve the time.
+        /// param [in,out]: time            Reference to variable in which the time in microseconds is stored.
+        ///                                 Time wraps around so only the differences between two times are meaningful.
+        /// returns: True if the time is available for specified digital input index, false otherwise.
+        bool digitalInEdgeTime(size_t digitalInIndex, uint32_t& time);
+
+        /// Retrieves the timing of digital input scanning and resets the longest measured scan duration.
+        /// Used to verify that the selected sampling rate leaves enough time to other interrupts.
+        /// param [in,out]: scanTime    Reference to variable in which scan timing is stored.
+        /// returns: True if scan duration is measured on this board, false otherwise.
+        bool digitalInScanTime(dInScanTime_t& scanTime);
+
         /// Calculates encoder index based on provided button index.
         /// param [in]: buttonID   Button index from which encoder is being calculated.
         /// returns: Calculated encoder index.
@@ -296,6 +337,14 @@ namespace Board
         /// returns: Calculated index of A or B signal of encoder.
         size_t encoderSignalIndex(size_t encoderID, encoderIndex_t index);
 
+        /// Retrieves the amount of pulses decoded by board since the last call.
+        /// Encoders are decoded either by timers or on every digital input sample.
+        /// Pulses are positive on clockwise movement.
+        /// param [in]: encoderID   Encoder which is being checked.
+        /// param [in,out]: pulses  Reference to variable in which decoded pulses are stored.
+        /// returns: True on success, false if encoder index is invalid.
+        bool encoderPulses(size_t encoderID, int16_t& pulses);
+
         /// Used to turn LED connected to the board on or off.
         /// param [in]: ledID           LED for which to change state.
         /// param [in]: brightnessLevel See ledBrightness_t enum.
@@ -20,6 +20,7 @@ limitations under the License.
 
 #include <stddef.h>
 #include <inttypes.h>
+#include <type_traits>
 #include "midi/src/MIDI.h"
 #include "core/src/general/IO.h"
 #include "board/Board.h"
@@ -60,6 +61,24 @@ namespace Board
 
             /// Initializes all used timers on board.
             void timers();
+
+            /// Initializes SPI peripheral and DMA streams used to read 74HC165 shift registers.
+            void spi();
+
+            /// Initializes timer and DMA streams used to scan button matrix without CPU involvement.
+            void matrixDMA();
+
+            /// Configures timers which decode the signals of encoders in hardware.
+            void encoderTimers();
+
+#ifdef __STM32__
+            /// NVIC priority of interrupts in which digital inputs are read: input timer
+            /// and DMA transfers which it starts. Lower than priority 0 used by main timer,
+            /// USB and UART so that input scanning can be preempted by them and doesn't delay
+            /// their handling. Both input interrupts use the same priority so that neither can
+            /// preempt the other while the readings are being processed.
+            constexpr uint32_t INPUT_IRQ_PRIORITY = 1;
+#endif
         }    // namespace setup
 
         namespace USB
@@ -169,6 +188,22 @@ namespace Board
             /// MCU-specific delay routine used when setting 74HC165 shift register state.
             void sr165wait();
 
+            /// Starts reading of already latched 74HC165 shift registers using SPI and DMA.
+            /// Once the transfer is complete, isrHandling::sr165() is called.
+            /// param [in]: buffer  Pointer to array in which read data will be stored.
+            /// param [in]: size    Amount of bytes (shift registers) to read.
+            /// returns: True if the transfer has been started, false otherwise.
+            bool sr165readSPI(uint8_t* buffer, size_t size);
+
+            /// Used to retrieve last complete frame of button matrix scanned using DMA.
+            /// returns: Pointer to array holding row port state for each column.
+            const volatile uint16_t* dInMatrixFrame();
+
+            /// Used to retrieve the counter of timer which decodes the encoder in hardware.
+            /// param [in]: index   Index of the timer in encoder timer table.
+            /// returns: Counter value which wraps around at 16 bits.
+            uint16_t encoderTimerCount(size_t index);
+
             /// Used to temporarily configure all common multiplexer pins as outputs to minimize
             /// the effect of channel-to-channel crosstalk.
             void dischargeMux();
@@ -176,6 +211,14 @@ namespace Board
             /// Used to restore pin setup for specified multiplexer.
             void restoreMux(uint8_t muxIndex);
 
+            /// Type used to describe single MCU port.
+            using mcuPort_t = decltype(core::io::mcuPin_t::port);
+
+            /// Reads the input states of all pins on specified port at once.
+            /// param [in]: port    Port which should be read.
+            /// returns: Input register of specified port where bit N holds the state of pin N.
+            uint32_t readPort(mcuPort_t port);
+
             /// Used as an descriptor for unused pins.
             typedef struct
             {
@@ -205,32 +248,63 @@ namespace Board
                 uint32_t size;
             } flashPage_t;
 
+            /// Type used for indexes of digital inputs in port descriptors.
+            /// Indexes don't fit into single byte with more than 256 inputs.
+            using dInIndex_t = std::conditional<(MAX_NUMBER_OF_BUTTONS > 256), uint16_t, uint8_t>::type;
+
+            /// Descriptor of single button pin used when reading entire port at once.
+            typedef struct
+            {
+                dInIndex_t buttonIndex;
+                uint8_t    pinIndex;
+            } dInPortPin_t;
+
+            /// Descriptor of single MCU port on which buttons are connected.
+            /// Pins belonging to the port are stored in numberOfPins consecutive
+            /// entries starting from firstPin.
+            typedef struct
+            {
+                io::mcuPort_t port;
+                uint32_t      mask;
+                dInIndex_t    firstPin;
+                dInIndex_t    numberOfPins;
+            } dInPort_t;
+
             /// Used to retrieve physical ADC channel for a given MCU pin.
             uint32_t adcChannel(const core::io::mcuPin_t& pin);
 
             /// Used to retrieve physical ADC channel for a given ADC channel index.
-            uint32_t adcChannel(uint8_t index);
+            uint32_t adcChannel(size_t index);
 
             /// Used to retrieve ADC port and pin for a given ADC channel index.
-            const core::io::mcuPin_t& adcPin(uint8_t index);
+            const core::io::mcuPin_t& adcPin(size_t index);
 
             /// Used to retrieve physical analog component index for a given user-specified index.
-            uint8_t adcIndex(uint8_t index);
+            size_t adcIndex(size_t index);
 
             /// Used to retrieve button port and pin for a given button index.
-            const core::io::mcuPin_t& buttonPin(uint8_t index);
+            const core::io::mcuPin_t& buttonPin(size_t index);
 
             /// Used to retrieve physical button component index for a given user-specified index.
-            uint8_t buttonIndex(uint8_t index);
+            size_t buttonIndex(size_t index);
+
+            /// Used to retrieve bit position of button matrix row within row port.
+            uint8_t buttonMatrixRowBit(size_t index);
+
+            /// Used to retrieve descriptor of MCU port with button inputs for a given port index.
+            const dInPort_t& buttonPort(size_t index);
+
+            /// Used to retrieve button pin descriptor for a given index in port pin table.
+            const dInPortPin_t& buttonPortPin(size_t index);
 
             /// Used to retrieve LED port and pin for a given LED index.
-            const core::io::mcuPin_t& ledPin(uint8_t index);
+            const core::io::mcuPin_t& ledPin(size_t index);
 
             /// Used to physical LED component index for a given user-specified index.
-            uint8_t ledIndex(uint8_t index);
+            size_t ledIndex(size_t index);
 
             /// Used to retrieve unused port and pin for a given index.
-            const Board::detail::io::unusedIO_t& unusedPin(uint8_t index);
+            const Board::detail::io::unusedIO_t& unusedPin(size_t index);
 
             /// Retrieves flash page descriptor containing page address and size.
             /// param [in]: pageIndex Index of flash sector for which to retrieve address and size.
@@ -238,6 +312,18 @@ namespace Board
             flashPage_t& flashPageDescriptor(size_t pageIndex);
 
 #ifdef __STM32__
+            /// Descriptor of timer used to decode encoder in hardware.
+            /// Signal A of the encoder needs to be connected to channel 1 of the timer and signal B to channel 2.
+            typedef struct
+            {
+                uint8_t      encoderIndex;
+                TIM_TypeDef* timer;
+                uint8_t      alternate;
+            } encoderTimer_t;
+
+            /// Used to retrieve descriptor of timer used to decode encoder for a given index in encoder timer table.
+            const encoderTimer_t& encoderTimer(size_t index);
+
             class STMPeripheral
             {
                 public:
@@ -280,6 +366,12 @@ namespace Board
 
             /// Global ISR handler for main timer.
             void mainTimer();
+
+            /// Global ISR handler for timer used to sample digital inputs.
+            void inputTimer();
+
+            /// Called once all 74HC165 shift registers have been read using SPI and DMA.
+            void sr165();
         }    // namespace isrHandling
 
         namespace flash
@@ -131,6 +131,16 @@ extern "C" void ADC_IRQHandler(void)
 #endif
 #endif
 
+#if defined(TIM3) && defined(FW_APP) && defined(INPUT_TIMER_INSTANCE)
+extern "C" void TIM3_IRQHandler(void)
+{
+    TIM3->SR = ~TIM_IT_UPDATE;
+
+    if (TIM3 == INPUT_TIMER_INSTANCE)
+        Board::detail::isrHandling::inputTimer();
+}
+#endif
+
 #ifdef TIM4
 extern "C" void TIM4_IRQHandler(void)
 {
@@ -140,6 +150,12 @@ extern "C" void TIM4_IRQHandler(void)
     {
         Board::detail::isrHandling::mainTimer();
     }
+#if defined(FW_APP) && defined(INPUT_TIMER_INSTANCE)
+    else if (TIM4 == INPUT_TIMER_INSTANCE)
+    {
+        Board::detail::isrHandling::inputTimer();
+    }
+#endif
     else if (TIM4 == PWM_TIMER_INSTANCE)
     {
 #ifdef FW_APP
@@ -162,6 +178,12 @@ extern "C" void TIM5_IRQHandler(void)
     {
         Board::detail::isrHandling::mainTimer();
     }
+#if defined(FW_APP) && defined(INPUT_TIMER_INSTANCE)
+    else if (TIM5 == INPUT_TIMER_INSTANCE)
+    {
+        Board::detail::isrHandling::inputTimer();
+    }
+#endif
     else if (TIM5 == PWM_TIMER_INSTANCE)
     {
 #ifdef FW_APP
@@ -184,6 +206,12 @@ extern "C" void TIM7_IRQHandler(void)
     {
         Board::detail::isrHandling::mainTimer();
     }
+#if defined(FW_APP) && defined(INPUT_TIMER_INSTANCE)
+    else if (TIM7 == INPUT_TIMER_INSTANCE)
+    {
+        Board::detail::isrHandling::inputTimer();
+    }
+#endif
     else if (TIM7 == PWM_TIMER_INSTANCE)
     {
 #ifdef FW_APP
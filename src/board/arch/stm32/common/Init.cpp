@@ -63,6 +63,15 @@ namespace Board
                 core::timing::waitMs(10);
 
                 detail::setup::io();
+#ifdef SR_IN_SPI
+                detail::setup::spi();
+#endif
+#ifdef BUTTON_MATRIX_DMA
+                detail::setup::matrixDMA();
+#endif
+#ifdef ENCODER_TIMERS
+                detail::setup::encoderTimers();
+#endif
                 detail::setup::adc();
                 detail::setup::timers();
 
@@ -0,0 +1,84 @@
+/*
+
+Copyright 2015-2021 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#include "board/Board.h"
+#include "board/Internal.h"
+#include "board/common/constants/IO.h"
+#include "core/src/general/Atomic.h"
+#include <MCU.h>
+
+#ifdef INPUT_TIMER_INSTANCE
+
+namespace
+{
+    /// Durations of digital input scanning in CPU cycles.
+    volatile uint32_t _lastScanCycles;
+    volatile uint32_t _maxScanCycles;
+
+    uint32_t cyclesToNs(uint32_t cycles)
+    {
+        return static_cast<uint64_t>(cycles) * 1000000000 / SystemCoreClock;
+    }
+}    // namespace
+
+namespace Board
+{
+    namespace io
+    {
+        bool digitalInScanTime(dInScanTime_t& scanTime)
+        {
+            uint32_t last;
+            uint32_t max;
+
+            ATOMIC_SECTION
+            {
+                last           = _lastScanCycles;
+                max            = _maxScanCycles;
+                _maxScanCycles = 0;
+            }
+
+            scanTime.period = 1000000000 / DIGITAL_IN_SAMPLING_RATE;
+            scanTime.last   = cyclesToNs(last);
+            scanTime.max    = cyclesToNs(max);
+
+            return true;
+        }
+    }    // namespace io
+
+    namespace detail
+    {
+        namespace isrHandling
+        {
+            void inputTimer()
+            {
+                const uint32_t start = DWT->CYCCNT;
+
+                Board::detail::io::checkDigitalInputs();
+
+                //unsigned subtraction handles counter overflow
+                //time spent in interrupts which have preempted the scan is included
+                _lastScanCycles = DWT->CYCCNT - start;
+
+                if (_lastScanCycles > _maxScanCycles)
+                    _maxScanCycles = _lastScanCycles;
+            }
+        }    // namespace isrHandling
+    }        // namespace detail
+}    // namespace Board
+
+#endif
\ No newline at end of file
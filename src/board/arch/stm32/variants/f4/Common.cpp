@@ -18,13 +18,23 @@ limitations under the License.
 
 #include "board/Internal.h"
 #include "core/src/general/ADC.h"
+#include "board/common/constants/IO.h"
 #include <MCU.h>
 
 namespace
 {
+    /// Amount of timer ticks in 1 ms with timer prescaler set to 1.
+    constexpr uint32_t TIMER_TICKS_PER_MS = 42000;
+
     TIM_HandleTypeDef _mainTimerHandler;
     ADC_HandleTypeDef _adcHandler;
 
+#ifdef FW_APP
+#ifdef INPUT_TIMER_INSTANCE
+    TIM_HandleTypeDef _inputTimerHandler;
+#endif
+#endif
+
 #ifdef FW_APP
 #ifndef USB_LINK_MCU
 #if MAX_NUMBER_OF_LEDS > 0
@@ -106,7 +116,7 @@ namespace Board
                 _mainTimerHandler.Instance               = MAIN_TIMER_INSTANCE;
                 _mainTimerHandler.Init.Prescaler         = 1;
                 _mainTimerHandler.Init.CounterMode       = TIM_COUNTERMODE_UP;
-                _mainTimerHandler.Init.Period            = 41999;    //1ms
+                _mainTimerHandler.Init.Period            = TIMER_TICKS_PER_MS - 1;    //1ms
                 _mainTimerHandler.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
                 _mainTimerHandler.Init.RepetitionCounter = 0;
                 _mainTimerHandler.Init.AutoReloadPreload = 0;
@@ -114,6 +124,25 @@ namespace Board
                 HAL_TIM_Base_Init(&_mainTimerHandler);
                 HAL_TIM_Base_Start_IT(&_mainTimerHandler);
 
+#ifdef FW_APP
+#ifdef INPUT_TIMER_INSTANCE
+                //cycle counter is used to measure the duration of input scanning
+                CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+                DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+                _inputTimerHandler.Instance               = INPUT_TIMER_INSTANCE;
+                _inputTimerHandler.Init.Prescaler         = 1;
+                _inputTimerHandler.Init.CounterMode       = TIM_COUNTERMODE_UP;
+                _inputTimerHandler.Init.Period            = ((TIMER_TICKS_PER_MS * 1000) / DIGITAL_IN_SAMPLING_RATE) - 1;
+                _inputTimerHandler.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+                _inputTimerHandler.Init.RepetitionCounter = 0;
+                _inputTimerHandler.Init.AutoReloadPreload = 0;
+
+                HAL_TIM_Base_Init(&_inputTimerHandler);
+                HAL_TIM_Base_Start_IT(&_inputTimerHandler);
+#endif
+#endif
+
 #ifdef FW_APP
 #ifndef USB_LINK_MCU
 #if MAX_NUMBER_OF_LEDS > 0
@@ -198,12 +227,18 @@ extern "C" void HAL_ADC_MspInit(ADC_HandleTypeDef* hadc)
 
 extern "C" void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base)
 {
+#if defined(FW_APP) && defined(INPUT_TIMER_INSTANCE)
+    const uint32_t priority = htim_base->Instance == INPUT_TIMER_INSTANCE ? Board::detail::setup::INPUT_IRQ_PRIORITY : 0;
+#else
+    const uint32_t priority = 0;
+#endif
+
 #ifdef TIM2
     if (htim_base->Instance == TIM2)
     {
         __HAL_RCC_TIM2_CLK_ENABLE();
 
-        HAL_NVIC_SetPriority(TIM2_IRQn, 0, 0);
+        HAL_NVIC_SetPriority(TIM2_IRQn, priority, 0);
         HAL_NVIC_EnableIRQ(TIM2_IRQn);
     }
 #endif
@@ -212,7 +247,7 @@ extern "C" void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base)
     {
         __HAL_RCC_TIM3_CLK_ENABLE();
 
-        HAL_NVIC_SetPriority(TIM3_IRQn, 0, 0);
+        HAL_NVIC_SetPriority(TIM3_IRQn, priority, 0);
         HAL_NVIC_EnableIRQ(TIM3_IRQn);
     }
 #endif
@@ -221,7 +256,7 @@ extern "C" void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base)
     {
         __HAL_RCC_TIM4_CLK_ENABLE();
 
-        HAL_NVIC_SetPriority(TIM4_IRQn, 0, 0);
+        HAL_NVIC_SetPriority(TIM4_IRQn, priority, 0);
         HAL_NVIC_EnableIRQ(TIM4_IRQn);
     }
 #endif
@@ -230,7 +265,7 @@ extern "C" void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base)
     {
         __HAL_RCC_TIM5_CLK_ENABLE();
 
-        HAL_NVIC_SetPriority(TIM5_IRQn, 0, 0);
+        HAL_NVIC_SetPriority(TIM5_IRQn, priority, 0);
         HAL_NVIC_EnableIRQ(TIM5_IRQn);
     }
 #endif
@@ -239,7 +274,7 @@ extern "C" void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base)
     {
         __HAL_RCC_TIM6_CLK_ENABLE();
 
-        HAL_NVIC_SetPriority(TIM6_DAC_IRQn, 0, 0);
+        HAL_NVIC_SetPriority(TIM6_DAC_IRQn, priority, 0);
         HAL_NVIC_EnableIRQ(TIM6_DAC_IRQn);
     }
 #endif
@@ -248,7 +283,7 @@ extern "C" void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base)
     {
         __HAL_RCC_TIM7_CLK_ENABLE();
 
-        HAL_NVIC_SetPriority(TIM7_IRQn, 0, 0);
+        HAL_NVIC_SetPriority(TIM7_IRQn, priority, 0);
         HAL_NVIC_EnableIRQ(TIM7_IRQn);
     }
 #endif
@@ -257,7 +292,7 @@ extern "C" void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base)
     {
         __HAL_RCC_TIM12_CLK_ENABLE();
 
-        HAL_NVIC_SetPriority(TIM8_BRK_TIM12_IRQn, 0, 0);
+        HAL_NVIC_SetPriority(TIM8_BRK_TIM12_IRQn, priority, 0);
         HAL_NVIC_EnableIRQ(TIM8_BRK_TIM12_IRQn);
     }
 #endif
@@ -266,7 +301,7 @@ extern "C" void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base)
     {
         __HAL_RCC_TIM13_CLK_ENABLE();
 
-        HAL_NVIC_SetPriority(TIM8_UP_TIM13_IRQn, 0, 0);
+        HAL_NVIC_SetPriority(TIM8_UP_TIM13_IRQn, priority, 0);
         HAL_NVIC_EnableIRQ(TIM8_UP_TIM13_IRQn);
     }
 #endif
@@ -275,7 +310,7 @@ extern "C" void HAL_TIM_Base_MspInit(TIM_HandleTypeDef* htim_base)
     {
         __HAL_RCC_TIM14_CLK_ENABLE();
 
-        HAL_NVIC_SetPriority(TIM8_TRG_COM_TIM14_IRQn, 0, 0);
+        HAL_NVIC_SetPriority(TIM8_TRG_COM_TIM14_IRQn, priority, 0);
         HAL_NVIC_EnableIRQ(TIM8_TRG_COM_TIM14_IRQn);
     }
 #endif
@@ -0,0 +1,130 @@
+/*
+
+Copyright 2015-2021 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifdef FW_APP
+#ifdef ENCODER_TIMERS
+
+#include "board/Board.h"
+#include "board/Internal.h"
+#include <MCU.h>
+#include <Pins.h>
+
+//Selected encoders are decoded by timers in encoder mode instead of in software.
+//Signals A and B are connected to channels 1 and 2 of the timer which counts both
+//edges of both signals, so no transition is missed regardless of the sampling rate.
+//Input data register still reflects the state of pins in alternate mode, so both signals
+//are sampled as regular digital inputs as well.
+
+namespace
+{
+    TIM_HandleTypeDef _encoderTimerHandler[NUMBER_OF_ENCODER_TIMERS];
+
+    void enableClock(TIM_TypeDef* timer)
+    {
+        if (timer == TIM1)
+            __HAL_RCC_TIM1_CLK_ENABLE();
+        else if (timer == TIM2)
+            __HAL_RCC_TIM2_CLK_ENABLE();
+        else if (timer == TIM3)
+            __HAL_RCC_TIM3_CLK_ENABLE();
+        else if (timer == TIM4)
+            __HAL_RCC_TIM4_CLK_ENABLE();
+        else if (timer == TIM5)
+            __HAL_RCC_TIM5_CLK_ENABLE();
+#ifdef TIM8
+        else if (timer == TIM8)
+            __HAL_RCC_TIM8_CLK_ENABLE();
+#endif
+        else
+            Board::detail::errorHandler();
+    }
+
+    void configurePin(size_t encoderIndex, Board::io::encoderIndex_t signal, uint8_t alternate)
+    {
+        size_t             buttonIndex = Board::detail::map::buttonIndex(Board::io::encoderSignalIndex(encoderIndex, signal));
+        core::io::mcuPin_t pin         = Board::detail::map::buttonPin(buttonIndex);
+
+#ifndef BUTTONS_EXT_PULLUPS
+        CORE_IO_CONFIG({ CORE_IO_MCU_PIN_PORT(pin), CORE_IO_MCU_PIN_INDEX(pin), core::io::pinMode_t::alternatePP, core::io::pullMode_t::up, core::io::gpioSpeed_t::medium, alternate });
+#else
+        CORE_IO_CONFIG({ CORE_IO_MCU_PIN_PORT(pin), CORE_IO_MCU_PIN_INDEX(pin), core::io::pinMode_t::alternatePP, core::io::pullMode_t::none, core::io::gpioSpeed_t::medium, alternate });
+#endif
+    }
+}    // namespace
+
+namespace Board
+{
+    namespace detail
+    {
+        namespace setup
+        {
+            void encoderTimers()
+            {
+                for (size_t i = 0; i < NUMBER_OF_ENCODER_TIMERS; i++)
+                {
+                    auto& descriptor = detail::map::encoderTimer(i);
+                    auto& handler    = _encoderTimerHandler[i];
+
+                    enableClock(descriptor.timer);
+                    configurePin(descriptor.encoderIndex, Board::io::encoderIndex_t::a, descriptor.alternate);
+                    configurePin(descriptor.encoderIndex, Board::io::encoderIndex_t::b, descriptor.alternate);
+
+                    handler.Instance               = descriptor.timer;
+                    handler.Init.Prescaler         = 0;
+                    handler.Init.CounterMode       = TIM_COUNTERMODE_UP;
+                    handler.Init.Period            = 0xFFFF;
+                    handler.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV4;
+                    handler.Init.RepetitionCounter = 0;
+                    handler.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+
+                    TIM_Encoder_InitTypeDef encoder = {};
+
+                    //count on both edges of both signals
+                    encoder.EncoderMode = TIM_ENCODERMODE_TI12;
+
+                    //input filters remove contact bounce shorter than few microseconds
+                    encoder.IC1Polarity  = TIM_ICPOLARITY_RISING;
+                    encoder.IC1Selection = TIM_ICSELECTION_DIRECTTI;
+                    encoder.IC1Prescaler = TIM_ICPSC_DIV1;
+                    encoder.IC1Filter    = 0x0F;
+                    encoder.IC2Polarity  = TIM_ICPOLARITY_RISING;
+                    encoder.IC2Selection = TIM_ICSELECTION_DIRECTTI;
+                    encoder.IC2Prescaler = TIM_ICPSC_DIV1;
+                    encoder.IC2Filter    = 0x0F;
+
+                    if (HAL_TIM_Encoder_Init(&handler, &encoder) != HAL_OK)
+                        Board::detail::errorHandler();
+
+                    if (HAL_TIM_Encoder_Start(&handler, TIM_CHANNEL_ALL) != HAL_OK)
+                        Board::detail::errorHandler();
+                }
+            }
+        }    // namespace setup
+
+        namespace io
+        {
+            uint16_t encoderTimerCount(size_t index)
+            {
+                return detail::map::encoderTimer(index).timer->CNT & 0xFFFF;
+            }
+        }    // namespace io
+    }        // namespace detail
+}    // namespace Board
+
+#endif
+#endif
@@ -0,0 +1,156 @@
+/*
+
+Copyright 2015-2021 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifdef FW_APP
+#ifdef BUTTON_MATRIX_DMA
+
+#include "board/Board.h"
+#include "board/Internal.h"
+#include "board/common/constants/IO.h"
+#include <MCU.h>
+#include <Pins.h>
+
+//Button matrix is scanned without CPU involvement. On each update event of TIM1, DMA writes
+//the decoder pattern for next column to BSRR register of decoder port. Once the column has
+//settled, compare event of the same timer triggers second DMA which copies IDR register of
+//row port into frame buffer. Row DMA runs in circular mode over two frames so that one
+//complete frame is always available while the other one is being filled.
+
+namespace
+{
+    TIM_HandleTypeDef _matrixTimerHandler;
+    DMA_HandleTypeDef _dmaColumnHandler;
+    DMA_HandleTypeDef _dmaRowHandler;
+
+    /// BSRR values which activate the specific column on decoder.
+    /// Pattern for column 0 is written before the timer is started so that the update event
+    /// always activates the column after the one whose rows have just been captured.
+    uint32_t _columnPatterns[NUMBER_OF_BUTTON_COLUMNS];
+
+    /// Row port states for each column, for two complete frames.
+    volatile uint16_t _rowFrames[2][NUMBER_OF_BUTTON_COLUMNS];
+
+    /// Calculates the amount of TIM1 ticks for single column with timer prescaler set to 1.
+    /// TIM1 is located on APB2 bus, so its clock differs from the clock of other used timers.
+    uint32_t columnPeriod()
+    {
+        uint32_t timerClock = HAL_RCC_GetPCLK2Freq();
+
+        //timer clock is doubled when APB2 clock is divided (top bit of prescaler is set)
+        if (RCC->CFGR & RCC_CFGR_PPRE2_2)
+            timerClock *= 2;
+
+        return (timerClock / 2) / (DIGITAL_IN_SAMPLING_RATE * NUMBER_OF_BUTTON_COLUMNS);
+    }
+
+    uint32_t columnPattern(uint8_t column)
+    {
+        const uint8_t decoderPins[3] = { DEC_BM_INDEX_A0, DEC_BM_INDEX_A1, DEC_BM_INDEX_A2 };
+        uint32_t      pattern        = 0;
+
+        for (size_t i = 0; i < 3; i++)
+        {
+            //lower half of BSRR sets the pin, upper half resets it
+            if ((column >> i) & 0x01)
+                pattern |= (static_cast<uint32_t>(1) << decoderPins[i]);
+            else
+                pattern |= (static_cast<uint32_t>(1) << (decoderPins[i] + 16));
+        }
+
+        return pattern;
+    }
+
+    void initDMA(DMA_HandleTypeDef& handler, DMA_Stream_TypeDef* stream, uint32_t direction, uint32_t alignment)
+    {
+        handler.Instance                 = stream;
+        handler.Init.Channel             = DMA_CHANNEL_6;
+        handler.Init.Direction           = direction;
+        handler.Init.PeriphInc           = DMA_PINC_DISABLE;
+        handler.Init.MemInc              = DMA_MINC_ENABLE;
+        handler.Init.PeriphDataAlignment = alignment == DMA_MDATAALIGN_WORD ? DMA_PDATAALIGN_WORD : DMA_PDATAALIGN_HALFWORD;
+        handler.Init.MemDataAlignment    = alignment;
+        handler.Init.Mode                = DMA_CIRCULAR;
+        handler.Init.Priority            = DMA_PRIORITY_HIGH;
+        handler.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+
+        if (HAL_DMA_Init(&handler) != HAL_OK)
+            Board::detail::errorHandler();
+    }
+}    // namespace
+
+namespace Board
+{
+    namespace detail
+    {
+        namespace setup
+        {
+            void matrixDMA()
+            {
+                const uint32_t period = columnPeriod();
+
+                for (size_t column = 0; column < NUMBER_OF_BUTTON_COLUMNS; column++)
+                    _columnPatterns[column] = columnPattern((column + 1) % NUMBER_OF_BUTTON_COLUMNS);
+
+                DEC_BM_PORT->BSRR = columnPattern(0);
+
+                //only DMA2 is able to access GPIO registers
+                __HAL_RCC_DMA2_CLK_ENABLE();
+                __HAL_RCC_TIM1_CLK_ENABLE();
+
+                //TIM1_UP request
+                initDMA(_dmaColumnHandler, DMA2_Stream5, DMA_MEMORY_TO_PERIPH, DMA_MDATAALIGN_WORD);
+
+                //TIM1_CH1 request
+                initDMA(_dmaRowHandler, DMA2_Stream1, DMA_PERIPH_TO_MEMORY, DMA_MDATAALIGN_HALFWORD);
+
+                _matrixTimerHandler.Instance               = TIM1;
+                _matrixTimerHandler.Init.Prescaler         = 1;
+                _matrixTimerHandler.Init.CounterMode       = TIM_COUNTERMODE_UP;
+                _matrixTimerHandler.Init.Period            = period - 1;
+                _matrixTimerHandler.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+                _matrixTimerHandler.Init.RepetitionCounter = 0;
+                _matrixTimerHandler.Init.AutoReloadPreload = 0;
+
+                HAL_TIM_Base_Init(&_matrixTimerHandler);
+
+                //capture rows as late as possible in column period to leave enough time for settling
+                TIM1->CCR1 = (period * 3) / 4;
+
+                HAL_DMA_Start(&_dmaColumnHandler, reinterpret_cast<uint32_t>(_columnPatterns), reinterpret_cast<uint32_t>(&DEC_BM_PORT->BSRR), NUMBER_OF_BUTTON_COLUMNS);
+                HAL_DMA_Start(&_dmaRowHandler, reinterpret_cast<uint32_t>(&DIN_MATRIX_ROW_PORT->IDR), reinterpret_cast<uint32_t>(_rowFrames), NUMBER_OF_BUTTON_COLUMNS * 2);
+
+                __HAL_TIM_ENABLE_DMA(&_matrixTimerHandler, TIM_DMA_UPDATE | TIM_DMA_CC1);
+                HAL_TIM_Base_Start(&_matrixTimerHandler);
+            }
+        }    // namespace setup
+
+        namespace io
+        {
+            const volatile uint16_t* dInMatrixFrame()
+            {
+                //frame which isn't currently being written to by DMA is complete
+                uint32_t written = (NUMBER_OF_BUTTON_COLUMNS * 2) - __HAL_DMA_GET_COUNTER(&_dmaRowHandler);
+
+                return written < NUMBER_OF_BUTTON_COLUMNS ? _rowFrames[1] : _rowFrames[0];
+            }
+        }    // namespace io
+    }        // namespace detail
+}    // namespace Board
+
+#endif
+#endif
\ No newline at end of file
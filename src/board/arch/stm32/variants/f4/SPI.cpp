@@ -0,0 +1,186 @@
+/*
+
+Copyright 2015-2021 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#ifdef FW_APP
+#ifdef SR_IN_SPI
+
+#include "board/Board.h"
+#include "board/Internal.h"
+#include <MCU.h>
+#include <Pins.h>
+
+//74HC165 chain is read using SPI in master mode: clock pin of the chain is used as SCK
+//and data pin as MISO. MOSI isn't used. Peripheral, alternate function and DMA streams
+//are selected based on SR_IN_SPI value (SPI peripheral number).
+
+#if SR_IN_SPI == 1
+#define SR_IN_SPI_INSTANCE        SPI1
+#define SR_IN_SPI_ALTERNATE       GPIO_AF5_SPI1
+#define SR_IN_SPI_PRESCALER       SPI_BAUDRATEPRESCALER_16
+#define SR_IN_SPI_CLK_ENABLE()    __HAL_RCC_SPI1_CLK_ENABLE()
+#define SR_IN_DMA_CLK_ENABLE()    __HAL_RCC_DMA2_CLK_ENABLE()
+#define SR_IN_DMA_CHANNEL         DMA_CHANNEL_3
+#define SR_IN_DMA_RX_STREAM       DMA2_Stream0
+#define SR_IN_DMA_RX_IRQn         DMA2_Stream0_IRQn
+#define SR_IN_DMA_RX_IRQ_HANDLER  DMA2_Stream0_IRQHandler
+#define SR_IN_DMA_TX_STREAM       DMA2_Stream3
+#define SR_IN_DMA_TX_IRQn         DMA2_Stream3_IRQn
+#define SR_IN_DMA_TX_IRQ_HANDLER  DMA2_Stream3_IRQHandler
+#elif SR_IN_SPI == 2
+#define SR_IN_SPI_INSTANCE        SPI2
+#define SR_IN_SPI_ALTERNATE       GPIO_AF5_SPI2
+#define SR_IN_SPI_PRESCALER       SPI_BAUDRATEPRESCALER_8
+#define SR_IN_SPI_CLK_ENABLE()    __HAL_RCC_SPI2_CLK_ENABLE()
+#define SR_IN_DMA_CLK_ENABLE()    __HAL_RCC_DMA1_CLK_ENABLE()
+#define SR_IN_DMA_CHANNEL         DMA_CHANNEL_0
+#define SR_IN_DMA_RX_STREAM       DMA1_Stream3
+#define SR_IN_DMA_RX_IRQn         DMA1_Stream3_IRQn
+#define SR_IN_DMA_RX_IRQ_HANDLER  DMA1_Stream3_IRQHandler
+#define SR_IN_DMA_TX_STREAM       DMA1_Stream4
+#define SR_IN_DMA_TX_IRQn         DMA1_Stream4_IRQn
+#define SR_IN_DMA_TX_IRQ_HANDLER  DMA1_Stream4_IRQHandler
+#elif SR_IN_SPI == 3
+#define SR_IN_SPI_INSTANCE        SPI3
+#define SR_IN_SPI_ALTERNATE       GPIO_AF6_SPI3
+#define SR_IN_SPI_PRESCALER       SPI_BAUDRATEPRESCALER_8
+#define SR_IN_SPI_CLK_ENABLE()    __HAL_RCC_SPI3_CLK_ENABLE()
+#define SR_IN_DMA_CLK_ENABLE()    __HAL_RCC_DMA1_CLK_ENABLE()
+#define SR_IN_DMA_CHANNEL         DMA_CHANNEL_0
+#define SR_IN_DMA_RX_STREAM       DMA1_Stream0
+#define SR_IN_DMA_RX_IRQn         DMA1_Stream0_IRQn
+#define SR_IN_DMA_RX_IRQ_HANDLER  DMA1_Stream0_IRQHandler
+#define SR_IN_DMA_TX_STREAM       DMA1_Stream5
+#define SR_IN_DMA_TX_IRQn         DMA1_Stream5_IRQn
+#define SR_IN_DMA_TX_IRQ_HANDLER  DMA1_Stream5_IRQHandler
+#else
+#error Unsupported SPI peripheral for 74HC165 readout
+#endif
+
+namespace
+{
+    SPI_HandleTypeDef _spiHandler;
+    DMA_HandleTypeDef _dmaRxHandler;
+    DMA_HandleTypeDef _dmaTxHandler;
+
+    /// MOSI isn't connected, but full-duplex master mode needs something to send.
+    uint8_t _dummyTx[NUMBER_OF_IN_SR];
+}    // namespace
+
+namespace Board
+{
+    namespace detail
+    {
+        namespace setup
+        {
+            void spi()
+            {
+                _spiHandler.Instance               = SR_IN_SPI_INSTANCE;
+                _spiHandler.Init.Mode              = SPI_MODE_MASTER;
+                _spiHandler.Init.Direction         = SPI_DIRECTION_2LINES;
+                _spiHandler.Init.DataSize          = SPI_DATASIZE_8BIT;
+                _spiHandler.Init.CLKPolarity       = SPI_POLARITY_LOW;
+                _spiHandler.Init.CLKPhase          = SPI_PHASE_1EDGE;
+                _spiHandler.Init.NSS               = SPI_NSS_SOFT;
+                _spiHandler.Init.BaudRatePrescaler = SR_IN_SPI_PRESCALER;
+                _spiHandler.Init.FirstBit          = SPI_FIRSTBIT_MSB;
+                _spiHandler.Init.TIMode            = SPI_TIMODE_DISABLE;
+                _spiHandler.Init.CRCCalculation    = SPI_CRCCALCULATION_DISABLE;
+                _spiHandler.Init.CRCPolynomial     = 10;
+
+                if (HAL_SPI_Init(&_spiHandler) != HAL_OK)
+                    Board::detail::errorHandler();
+            }
+        }    // namespace setup
+
+        namespace io
+        {
+            bool sr165readSPI(uint8_t* buffer, size_t size)
+            {
+                return HAL_SPI_TransmitReceive_DMA(&_spiHandler, _dummyTx, buffer, size) == HAL_OK;
+            }
+        }    // namespace io
+    }        // namespace detail
+}    // namespace Board
+
+extern "C" void HAL_SPI_MspInit(SPI_HandleTypeDef* hspi)
+{
+    if (hspi->Instance != SR_IN_SPI_INSTANCE)
+        return;
+
+    SR_IN_SPI_CLK_ENABLE();
+    SR_IN_DMA_CLK_ENABLE();
+
+    CORE_IO_CONFIG({ SR_IN_CLK_PORT, SR_IN_CLK_PIN, core::io::pinMode_t::alternatePP, core::io::pullMode_t::none, core::io::gpioSpeed_t::veryHigh, SR_IN_SPI_ALTERNATE });
+    CORE_IO_CONFIG({ SR_IN_DATA_PORT, SR_IN_DATA_PIN, core::io::pinMode_t::alternatePP, core::io::pullMode_t::none, core::io::gpioSpeed_t::veryHigh, SR_IN_SPI_ALTERNATE });
+
+    _dmaRxHandler.Instance                 = SR_IN_DMA_RX_STREAM;
+    _dmaRxHandler.Init.Channel             = SR_IN_DMA_CHANNEL;
+    _dmaRxHandler.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+    _dmaRxHandler.Init.PeriphInc           = DMA_PINC_DISABLE;
+    _dmaRxHandler.Init.MemInc              = DMA_MINC_ENABLE;
+    _dmaRxHandler.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    _dmaRxHandler.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+    _dmaRxHandler.Init.Mode                = DMA_NORMAL;
+    _dmaRxHandler.Init.Priority            = DMA_PRIORITY_HIGH;
+    _dmaRxHandler.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+
+    if (HAL_DMA_Init(&_dmaRxHandler) != HAL_OK)
+        Board::detail::errorHandler();
+
+    __HAL_LINKDMA(hspi, hdmarx, _dmaRxHandler);
+
+    _dmaTxHandler.Instance                 = SR_IN_DMA_TX_STREAM;
+    _dmaTxHandler.Init.Channel             = SR_IN_DMA_CHANNEL;
+    _dmaTxHandler.Init.Direction           = DMA_MEMORY_TO_PERIPH;
+    _dmaTxHandler.Init.PeriphInc           = DMA_PINC_DISABLE;
+    _dmaTxHandler.Init.MemInc              = DMA_MINC_ENABLE;
+    _dmaTxHandler.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    _dmaTxHandler.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+    _dmaTxHandler.Init.Mode                = DMA_NORMAL;
+    _dmaTxHandler.Init.Priority            = DMA_PRIORITY_LOW;
+    _dmaTxHandler.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+
+    if (HAL_DMA_Init(&_dmaTxHandler) != HAL_OK)
+        Board::detail::errorHandler();
+
+    __HAL_LINKDMA(hspi, hdmatx, _dmaTxHandler);
+
+    HAL_NVIC_SetPriority(SR_IN_DMA_RX_IRQn, Board::detail::setup::INPUT_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(SR_IN_DMA_RX_IRQn);
+    HAL_NVIC_SetPriority(SR_IN_DMA_TX_IRQn, Board::detail::setup::INPUT_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(SR_IN_DMA_TX_IRQn);
+}
+
+extern "C" void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    if (hspi->Instance == SR_IN_SPI_INSTANCE)
+        Board::detail::isrHandling::sr165();
+}
+
+extern "C" void SR_IN_DMA_RX_IRQ_HANDLER(void)
+{
+    HAL_DMA_IRQHandler(&_dmaRxHandler);
+}
+
+extern "C" void SR_IN_DMA_TX_IRQ_HANDLER(void)
+{
+    HAL_DMA_IRQHandler(&_dmaTxHandler);
+}
+
+#endif
+#endif
\ No newline at end of file
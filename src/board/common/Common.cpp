@@ -20,6 +20,7 @@ limitations under the License.
 #include "board/Internal.h"
 #include "core/src/general/Reset.h"
 #include "core/src/general/Timing.h"
+#include <MCU.h>
 
 #ifndef USB_SUPPORTED
 #include "board/common/comm/USBOverSerial/USBOverSerial.h"
@@ -98,7 +99,10 @@ namespace Board
                 Board::detail::io::checkIndicators();
 
 #ifdef FW_APP
+#ifndef INPUT_TIMER_INSTANCE
+                //inputs are sampled from main timer only if there is no dedicated timer for them
                 Board::detail::io::checkDigitalInputs();
+#endif
 #endif
             }
         }    // namespace isrHandling
@@ -22,4 +22,34 @@ limitations under the License.
 #define MIDI_INDICATOR_TIMEOUT 50
 
 /// Time in milliseconds for single startup animation cycle on built-in LED indicators.
-#define LED_INDICATOR_STARTUP_DELAY 150
\ No newline at end of file
+#define LED_INDICATOR_STARTUP_DELAY 150
+
+/// Rate in Hz at which digital inputs are sampled.
+/// Rates other than 1 kHz are possible only on boards with dedicated input timer,
+/// otherwise inputs are sampled from main timer.
+#ifndef DIGITAL_IN_SAMPLING_RATE
+#define DIGITAL_IN_SAMPLING_RATE 1000
+#endif
+
+/// Amount of consecutive digital input samples in which the input needs to be
+/// active before it's considered pressed.
+#ifndef DIGITAL_IN_DEBOUNCE_PRESS_SAMPLES
+#define DIGITAL_IN_DEBOUNCE_PRESS_SAMPLES 1
+#endif
+
+/// Amount of consecutive digital input samples in which the input needs to be
+/// inactive before it's considered released. Defaults to 5 ms regardless of sampling rate.
+#ifndef DIGITAL_IN_DEBOUNCE_RELEASE_SAMPLES
+#define DIGITAL_IN_DEBOUNCE_RELEASE_SAMPLES ((5 * DIGITAL_IN_SAMPLING_RATE) / 1000)
+#endif
+
+/// Width of debouncing counters in bits. Counters need to be able to hold the largest threshold.
+#if (DIGITAL_IN_DEBOUNCE_PRESS_SAMPLES > 31) || (DIGITAL_IN_DEBOUNCE_RELEASE_SAMPLES > 31)
+#define DIGITAL_IN_DEBOUNCE_COUNTER_BITS 6
+#elif (DIGITAL_IN_DEBOUNCE_PRESS_SAMPLES > 15) || (DIGITAL_IN_DEBOUNCE_RELEASE_SAMPLES > 15)
+#define DIGITAL_IN_DEBOUNCE_COUNTER_BITS 5
+#elif (DIGITAL_IN_DEBOUNCE_PRESS_SAMPLES > 7) || (DIGITAL_IN_DEBOUNCE_RELEASE_SAMPLES > 7)
+#define DIGITAL_IN_DEBOUNCE_COUNTER_BITS 4
+#else
+#define DIGITAL_IN_DEBOUNCE_COUNTER_BITS 3
+#endif
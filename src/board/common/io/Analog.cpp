@@ -19,9 +19,9 @@ limitations under the License.
 #include "board/common/constants/IO.h"
 #include "core/src/general/ADC.h"
 #include "core/src/general/Helpers.h"
-#include "core/src/general/Atomic.h"
 #include "board/Board.h"
 #include "board/Internal.h"
+#include "board/common/io/DoubleBuffer.h"
 #include <Pins.h>
 
 #ifndef NUMBER_OF_MUX
@@ -30,13 +30,32 @@ limitations under the License.
 #define ANALOG_IN_BUFFER_SIZE (NUMBER_OF_MUX_INPUTS * NUMBER_OF_MUX)
 #endif
 
-/// Used to indicate that the new reading has been made.
-#define NEW_READING_FLAG 0x8000
-
 namespace
 {
-    uint8_t           _analogIndex;
-    volatile uint16_t _analogBuffer[ANALOG_IN_BUFFER_SIZE];
+    /// Values of all analog inputs after single complete scan.
+    struct aInFrame_t
+    {
+        uint16_t values[ANALOG_IN_BUFFER_SIZE];
+    };
+
+    uint8_t _analogIndex;
+
+    /// Values read so far in current scan. Scan takes many ADC interrupts, so values are
+    /// collected here and copied to the back frame at once, right before it's published.
+    /// Filling the back frame directly could overwrite the frame reader is copying.
+    aInFrame_t _analogScan;
+
+    /// Frames published from ADC interrupt once all analog inputs are read.
+    Board::detail::io::DoubleBuffer<aInFrame_t> _analogFrames;
+
+    /// Frame currently used by application.
+    aInFrame_t _analogSnapshot;
+
+    /// Sequence number of the frame currently used by application.
+    uint8_t _analogSnapshotSequence;
+
+    /// Bitmap of values in current snapshot which haven't been read by application yet.
+    uint32_t _analogNew[(ANALOG_IN_BUFFER_SIZE + 31) / 32];
 
 #ifdef NUMBER_OF_MUX
     uint8_t _activeMux;
@@ -66,19 +85,23 @@ namespace Board
 
             analogID = detail::map::adcIndex(analogID);
 
-            ATOMIC_SECTION
+            if (!((_analogNew[analogID / 32] >> (analogID % 32)) & 0x01))
             {
-                value = _analogBuffer[analogID];
-                _analogBuffer[analogID] &= ~NEW_READING_FLAG;
-            }
+                if (_analogFrames.sequence() == _analogSnapshotSequence)
+                    return false;
 
-            if (value & NEW_READING_FLAG)
-            {
-                value &= ~NEW_READING_FLAG;
-                return true;
+                //all values from current snapshot have been read - take the new one
+                _analogSnapshotSequence = _analogFrames.read(_analogSnapshot);
+
+                for (size_t word = 0; word < (ANALOG_IN_BUFFER_SIZE + 31) / 32; word++)
+                    _analogNew[word] = 0xFFFFFFFF;
             }
 
-            return false;
+            _analogNew[analogID / 32] &= ~(static_cast<uint32_t>(1) << (analogID % 32));
+
+            value = _analogSnapshot.values[analogID];
+
+            return true;
         }
     }    // namespace io
 
@@ -98,8 +121,7 @@ namespace Board
                     detail::io::dischargeMux();
 #endif
 
-                    _analogBuffer[_analogIndex] = adcValue;
-                    _analogBuffer[_analogIndex] |= NEW_READING_FLAG;
+                    _analogScan.values[_analogIndex] = adcValue;
                     _analogIndex++;
 #ifdef NUMBER_OF_MUX
                     _activeMuxInput++;
@@ -119,7 +141,9 @@ namespace Board
                         {
                             _activeMux = 0;
 #endif
-                            _analogIndex = 0;
+                            _analogIndex          = 0;
+                            _analogFrames.back() = _analogScan;
+                            _analogFrames.publish();
 #ifdef NUMBER_OF_MUX
                         }
 #endif
@@ -0,0 +1,132 @@
+/*
+
+Copyright 2015-2021 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include "DoubleBuffer.h"
+
+namespace Board
+{
+    namespace detail
+    {
+        namespace io
+        {
+            /// Exchange of debounced input states between interrupt and application in which
+            /// frame is published only once some input has changed.
+            /// Changes are accumulated by the writer until the reader acknowledges the frame in
+            /// which it has seen them, so that no change is lost between two polls.
+            /// Polls made while nothing has changed only compare the sequence number and don't copy the frame.
+            template<typename bitmap_t>
+            class ChangedFrames
+            {
+                public:
+                struct frame_t
+                {
+                    bitmap_t debounced;    ///< Debounced state of each input.
+                    bitmap_t changed;      ///< Inputs changed since the last acknowledged frame.
+                };
+
+                ChangedFrames() = default;
+
+                /// Starts building the next frame. Changes seen by the reader are dropped here.
+                void begin()
+                {
+                    _clear = false;
+
+                    //acknowledged sequence is checked only once so it can't change while being compared
+                    if (_ackPending)
+                    {
+                        _ackPending = false;
+                        _clear      = _ackSequence == _frames.sequence();
+                    }
+
+                    _anyChanged = false;
+                }
+
+                /// Stores the states of 32 inputs for the frame being built.
+                /// param [in]: word        Index of 32-bit word in bitmap.
+                /// param [in]: debounced   Debounced state of inputs.
+                /// param [in]: changed     Inputs which have changed in this sample.
+                void store(size_t word, uint32_t debounced, uint32_t changed)
+                {
+                    if (_clear)
+                        _changed[word] = 0;
+
+                    _changed[word] |= changed;
+
+                    _debounced[word] = debounced;
+
+                    if (_changed[word])
+                        _anyChanged = true;
+                }
+
+                /// Publishes the frame being built if it contains any change not yet acknowledged by the reader.
+                /// returns: True if the frame has been published.
+                bool end()
+                {
+                    if (!_anyChanged)
+                        return false;
+
+                    //back frame is written only when it's published within the same call
+                    //so that the frame which the reader could be copying is never touched
+                    auto& frame = _frames.back();
+
+                    frame.debounced = _debounced;
+                    frame.changed   = _changed;
+
+                    _frames.publish();
+                    return true;
+                }
+
+                /// Copies the last published frame if it hasn't been copied already and acknowledges it.
+                /// param [in,out]: frame   Reference to variable in which the frame is copied.
+                /// returns: True if the frame has been copied, false if nothing has been published since the last call.
+                bool poll(frame_t& frame)
+                {
+                    if (_frames.sequence() == _readSequence)
+                        return false;
+
+                    _readSequence = _frames.read(frame);
+
+                    //let the writer know that these changes don't need to be kept anymore
+                    _ackSequence = _readSequence;
+                    _ackPending  = true;
+
+                    return true;
+                }
+
+                private:
+                DoubleBuffer<frame_t> _frames;
+
+                /// States of the frame being built and changes accumulated since the last acknowledged frame.
+                /// Used only by the writer.
+                bitmap_t _debounced  = {};
+                bitmap_t _changed    = {};
+                bool     _clear      = false;
+                bool     _anyChanged = false;
+
+                /// Sequence number of the last frame copied by the reader.
+                uint8_t _readSequence = 0;
+
+                /// Set by the reader, checked only once by the writer once the pending flag is set.
+                volatile uint8_t _ackSequence = 0;
+                volatile bool    _ackPending  = false;
+            };
+        }    // namespace io
+    }        // namespace detail
+}    // namespace Board
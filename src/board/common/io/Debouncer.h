@@ -0,0 +1,164 @@
+/*
+
+Copyright 2015-2021 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <inttypes.h>
+
+namespace Board
+{
+    namespace detail
+    {
+        namespace io
+        {
+            /// Debouncer operating on 32 inputs at once by using vertical counters:
+            /// bit N of every counter word belongs to input N, so incrementing, resetting
+            /// and comparing the counters of 32 inputs takes only a few logical operations.
+            /// Input changes its debounced state once the raw state has been different from
+            /// debounced state for threshold amount of consecutive samples. Separate thresholds
+            /// are used for press (0->1) and release (1->0).
+            template<size_t inputs, uint8_t counterBits = 3>
+            class Debouncer
+            {
+                public:
+                static constexpr size_t  WORDS         = (inputs + 31) / 32 ? (inputs + 31) / 32 : 1;
+                static constexpr uint8_t MAX_THRESHOLD = (1 << counterBits) - 1;
+
+                Debouncer(uint8_t pressThreshold, uint8_t releaseThreshold)
+                {
+                    setThresholds(pressThreshold, releaseThreshold);
+                }
+
+                /// Sets the amount of consecutive samples needed to change the debounced state.
+                /// Thresholds are constrained to 1 - MAX_THRESHOLD range. Threshold of 1 means
+                /// that the state will change immediately.
+                void setThresholds(uint8_t pressThreshold, uint8_t releaseThreshold)
+                {
+                    pressThreshold   = constrainThreshold(pressThreshold);
+                    releaseThreshold = constrainThreshold(releaseThreshold);
+
+                    for (size_t bit = 0; bit < counterBits; bit++)
+                    {
+                        _pressMask[bit]   = (pressThreshold >> bit) & 0x01 ? 0xFFFFFFFF : 0;
+                        _releaseMask[bit] = (releaseThreshold >> bit) & 0x01 ? 0xFFFFFFFF : 0;
+                    }
+                }
+
+                /// Stores the raw state of single input for next update.
+                void sample(size_t index, bool state)
+                {
+                    if (state)
+                        _sample[index / 32] |= (static_cast<uint32_t>(1) << (index % 32));
+                    else
+                        _sample[index / 32] &= ~(static_cast<uint32_t>(1) << (index % 32));
+                }
+
+                /// Runs single debouncing step using the last stored samples.
+                void update()
+                {
+                    for (size_t word = 0; word < WORDS; word++)
+                    {
+                        //inputs which differ from debounced state are counted, others are reset
+                        const uint32_t delta = _sample[word] ^ _state[word];
+                        uint32_t       carry = delta;
+
+                        for (size_t bit = 0; bit < counterBits; bit++)
+                        {
+                            const uint32_t counter = _counter[bit][word];
+
+                            _counter[bit][word] = (counter ^ carry) & delta;
+                            carry &= counter;
+                        }
+
+                        //compare counters with press threshold for released inputs
+                        //and with release threshold for pressed inputs
+                        uint32_t match = delta;
+
+                        for (size_t bit = 0; bit < counterBits; bit++)
+                        {
+                            const uint32_t threshold = (_pressMask[bit] & ~_state[word]) | (_releaseMask[bit] & _state[word]);
+                            match &= ~(_counter[bit][word] ^ threshold);
+                        }
+
+                        _state[word] ^= match;
+                        _changed[word] |= match;
+
+                        for (size_t bit = 0; bit < counterBits; bit++)
+                            _counter[bit][word] &= ~match;
+                    }
+                }
+
+                /// Returns debounced state of single input.
+                bool state(size_t index) const
+                {
+                    return (_state[index / 32] >> (index % 32)) & 0x01;
+                }
+
+                /// Returns debounced states of 32 inputs.
+                uint32_t stateWord(size_t word) const
+                {
+                    return _state[word];
+                }
+
+                /// Returns the mask of inputs which have changed debounced state since
+                /// the last call and clears it.
+                uint32_t changedWord(size_t word)
+                {
+                    uint32_t changed = _changed[word];
+                    _changed[word]   = 0;
+
+                    return changed;
+                }
+
+                /// Resets debounced state, counters and change masks of all inputs.
+                void reset()
+                {
+                    for (size_t word = 0; word < WORDS; word++)
+                    {
+                        _sample[word]  = 0;
+                        _state[word]   = 0;
+                        _changed[word] = 0;
+
+                        for (size_t bit = 0; bit < counterBits; bit++)
+                            _counter[bit][word] = 0;
+                    }
+                }
+
+                private:
+                static uint8_t constrainThreshold(uint8_t threshold)
+                {
+                    if (!threshold)
+                        return 1;
+
+                    if (threshold > MAX_THRESHOLD)
+                        return MAX_THRESHOLD;
+
+                    return threshold;
+                }
+
+                uint32_t _sample[WORDS]               = {};
+                uint32_t _state[WORDS]                = {};
+                uint32_t _changed[WORDS]              = {};
+                uint32_t _counter[counterBits][WORDS] = {};
+                uint32_t _pressMask[counterBits]      = {};
+                uint32_t _releaseMask[counterBits]    = {};
+            };
+        }    // namespace io
+    }        // namespace detail
+}    // namespace Board
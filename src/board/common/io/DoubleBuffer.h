@@ -0,0 +1,102 @@
+/*
+
+Copyright 2015-2021 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <inttypes.h>
+
+namespace Board
+{
+    namespace detail
+    {
+        namespace io
+        {
+            /// Lock-free exchange of complete frames between single writer running in interrupt
+            /// and single reader running in application. Writer fills the back frame and publishes
+            /// it by incrementing the sequence counter. Reader copies the front frame and retries
+            /// only if the writer has published twice during the copy, since only then the frame
+            /// being copied could have been overwritten. Writer must never be interrupted by the reader.
+            /// Back frame has to be filled and published within single interrupt: otherwise the writer
+            /// could overwrite the frame being copied after publishing only once.
+            /// Sequence counter is 8-bit so that it can be read atomically on all architectures.
+            template<typename frame_t>
+            class DoubleBuffer
+            {
+                public:
+                DoubleBuffer() = default;
+
+                /// Returns the frame which is being filled by the writer.
+                frame_t& back()
+                {
+                    return _frames[(_sequence + 1) & 0x01];
+                }
+
+                /// Returns the last published frame. Used by the writer to build the next
+                /// frame from the previous one.
+                const frame_t& front() const
+                {
+                    return _frames[_sequence & 0x01];
+                }
+
+                /// Makes the back frame visible to the reader.
+                void publish()
+                {
+                    barrier();
+                    _sequence++;
+                }
+
+                /// Returns the sequence number of the last published frame.
+                uint8_t sequence() const
+                {
+                    return _sequence;
+                }
+
+                /// Copies the last published frame.
+                /// param [in,out]: frame   Reference to variable in which the frame is copied.
+                /// returns: Sequence number of the copied frame.
+                uint8_t read(frame_t& frame) const
+                {
+                    uint8_t start;
+                    uint8_t end;
+
+                    do
+                    {
+                        start = _sequence;
+                        barrier();
+                        frame = _frames[start & 0x01];
+                        barrier();
+                        end = _sequence;
+                    } while (static_cast<uint8_t>(end - start) > 1);
+
+                    return start;
+                }
+
+                private:
+                /// Prevents the compiler from moving frame accesses across sequence counter accesses.
+                static void barrier()
+                {
+                    __asm__ volatile("" ::: "memory");
+                }
+
+                frame_t          _frames[2] = {};
+                volatile uint8_t _sequence  = 0;
+            };
+        }    // namespace io
+    }        // namespace detail
+}    // namespace Board
@@ -22,19 +22,266 @@ limitations under the License.
 #include "board/Board.h"
 #include "board/Internal.h"
 #include "board/common/constants/IO.h"
+#include "board/common/io/Debouncer.h"
+#include "board/common/io/ChangedFrames.h"
+#include "board/common/io/QuadratureDecoder.h"
 #include "core/src/general/Helpers.h"
 #include "core/src/general/Atomic.h"
 #include <Pins.h>
 
 namespace
 {
-    volatile Board::io::dInReadings_t _digitalInBuffer[MAX_NUMBER_OF_BUTTONS];
+    Board::detail::io::Debouncer<MAX_NUMBER_OF_BUTTONS, DIGITAL_IN_DEBOUNCE_COUNTER_BITS> _debouncer(DIGITAL_IN_DEBOUNCE_PRESS_SAMPLES, DIGITAL_IN_DEBOUNCE_RELEASE_SAMPLES);
 
-#ifdef NUMBER_OF_BUTTON_COLUMNS
+    /// Debounced states of digital inputs published from the interrupt in which they are sampled.
+    /// Indexed with physical digital input indexes.
+    /// Reading history isn't part of the frame so that it isn't stored three times.
+    Board::detail::io::ChangedFrames<Board::io::dInBitmap_t> _digitalInFrames;
+
+    /// Frame currently used by application. Taken once per poll of changed inputs.
+    Board::detail::io::ChangedFrames<Board::io::dInBitmap_t>::frame_t _digitalInSnapshot;
+
+    /// Last 32 readings of each input, newest in LSB bit.
+    /// Written only by the interrupt. Application reads single input at a time (see readReadings).
+    volatile uint32_t _digitalInReadings[MAX_NUMBER_OF_BUTTONS];
+
+    /// Total amount of samples taken so far.
+    volatile uint32_t _digitalInSample;
+
+    /// Incremented after every sample. 8-bit so that application can read it atomically
+    /// and detect the sample taken while it was reading the readings.
+    volatile uint8_t _digitalInSampleSequence;
+
+    /// Number of the sample at which each input has been last read by application.
+    uint32_t _digitalInLastSample[MAX_NUMBER_OF_BUTTONS];
+
+    /// Bitmap of digital inputs which have changed during the current sample.
+    uint32_t _digitalInChangedSample[std::tuple_size<Board::io::dInBitmap_t>::value];
+
+    /// Time in microseconds between two digital input samples.
+    constexpr uint32_t SAMPLE_PERIOD_US = 1000000 / DIGITAL_IN_SAMPLING_RATE;
+
+    /// Time in microseconds at which the latest digital input sample has been taken.
+    volatile uint32_t _sampleTime;
+
+    /// Holds the sample time of the last debounced state change for each digital input.
+    /// Indexed with physical digital input indexes.
+    volatile uint32_t _digitalInEdgeTime[MAX_NUMBER_OF_BUTTONS];
+
+    /// Stores the latest reading of digital input both in reading history and in debouncer.
+    inline void storeReading(size_t buttonIndex, bool state)
+    {
+        const uint32_t previous = _digitalInReadings[buttonIndex];
+
+        if (state != (previous & 0x01))
+            _digitalInChangedSample[buttonIndex / 32] |= (static_cast<uint32_t>(1) << (buttonIndex % 32));
+
+        _digitalInReadings[buttonIndex] = (previous << 1) | state;
+        _debouncer.sample(buttonIndex, state);
+    }
+
+    /// Reads the reading history of single input together with the number of the last sample.
+    /// Both are changed on every sample: retry if that happened during the read.
+    void readReadings(size_t buttonIndex, uint32_t& readings, uint32_t& sample)
+    {
+        uint8_t sequence;
+
+        do
+        {
+            sequence = _digitalInSampleSequence;
+            readings = _digitalInReadings[buttonIndex];
+            sample   = _digitalInSample;
+        } while (sequence != _digitalInSampleSequence);
+    }
+
+#ifdef ENCODERS_SUPPORTED
+    /// Running count of pulses decoded for each encoder. Counter is increased on clockwise
+    /// movement and is written only by the interrupt: application keeps the count at its last
+    /// read and uses the difference, so the counter never has to be cleared.
+    volatile uint16_t _encoderPulseCount[MAX_NUMBER_OF_ENCODERS];
+
+    /// Pulse count of each encoder at the last read by application.
+    uint16_t _encoderPulseRead[MAX_NUMBER_OF_ENCODERS];
+
+    /// Physical digital input indexes of the signals of encoders decoded in interrupt.
+    struct encoderSignals_t
+    {
+        struct
+        {
+            uint16_t encoder;
+            uint16_t a;
+            uint16_t b;
+        } signal[MAX_NUMBER_OF_ENCODERS];
+
+        uint16_t count;
+    };
+
+    /// Resolves the signal indexes once so that the mapping isn't repeated on every sample.
+    /// Encoders decoded by hardware timers are left out.
+    encoderSignals_t buildEncoderSignals()
+    {
+        encoderSignals_t signals = {};
+
+        for (size_t i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        {
+#ifdef ENCODER_TIMERS
+            bool timer = false;
+
+            for (size_t t = 0; t < NUMBER_OF_ENCODER_TIMERS; t++)
+            {
+                if (Board::detail::map::encoderTimer(t).encoderIndex == i)
+                    timer = true;
+            }
+
+            if (timer)
+                continue;
+#endif
+
+            auto& signal = signals.signal[signals.count++];
+
+            signal.encoder = i;
+            signal.a       = Board::detail::map::buttonIndex(Board::io::encoderSignalIndex(i, Board::io::encoderIndex_t::a));
+            signal.b       = Board::detail::map::buttonIndex(Board::io::encoderSignalIndex(i, Board::io::encoderIndex_t::b));
+        }
+
+        return signals;
+    }
+
+    const encoderSignals_t _encoderSignals = buildEncoderSignals();
+
+    /// Checks whether the reading of specified input has changed during the current sample.
+    inline bool changedInSample(size_t buttonIndex)
+    {
+        return _digitalInChangedSample[buttonIndex / 32] & (static_cast<uint32_t>(1) << (buttonIndex % 32));
+    }
+
+    /// Runs quadrature decoding step for all encoders on the latest readings.
+    /// Every sample is decoded as soon as it's taken so that no transition can be
+    /// lost before application reads the inputs. Encoders whose signals haven't changed
+    /// during the current sample are skipped, so this needs to run before the changes
+    /// of the sample are cleared.
+    inline void decodeEncoders()
+    {
+        for (size_t i = 0; i < _encoderSignals.count; i++)
+        {
+            const auto& signal = _encoderSignals.signal[i];
+
+            if (!changedInSample(signal.a) && !changedInSample(signal.b))
+                continue;
+
+            const int8_t pulse = Board::detail::io::quadraturePulse(_digitalInReadings[signal.a], _digitalInReadings[signal.b]);
+
+            if (pulse)
+                _encoderPulseCount[signal.encoder] += pulse;
+        }
+    }
+
+    /// Reads the pulse count of specified encoder.
+    /// Count can change on every sample: retry if that happened during the read.
+    uint16_t encoderPulseCount(size_t encoderID)
+    {
+        uint8_t  sequence;
+        uint16_t count;
+
+        do
+        {
+            sequence = _digitalInSampleSequence;
+            count    = _encoderPulseCount[encoderID];
+        } while (sequence != _digitalInSampleSequence);
+
+        return count;
+    }
+#endif
+
+    /// Runs debouncing step on the latest readings, marks the inputs which have changed
+    /// and publishes the frame to application if any of them has changed.
+    /// param [in]: sampleTime  Time at which the processed readings have been sampled.
+    inline void processDigitalIn(uint32_t sampleTime)
+    {
+        _debouncer.update();
+
+#ifdef ENCODERS_SUPPORTED
+        decodeEncoders();
+#endif
+
+        _digitalInFrames.begin();
+
+        for (size_t word = 0; word < std::tuple_size<Board::io::dInBitmap_t>::value; word++)
+        {
+            uint32_t changed = _debouncer.changedWord(word);
+
+            _digitalInFrames.store(word, _debouncer.stateWord(word), changed | _digitalInChangedSample[word]);
+            _digitalInChangedSample[word] = 0;
+
+            //timestamp the inputs which have changed debounced state
+            while (changed)
+            {
+                _digitalInEdgeTime[(word * 32) + __builtin_ctz(changed)] = sampleTime;
+                changed &= changed - 1;
+            }
+        }
+
+        _digitalInSample++;
+        _digitalInSampleSequence++;
+
+        //idle samples aren't published so that application doesn't copy anything until something changes
+        _digitalInFrames.end();
+    }
+
+#if defined(NUMBER_OF_BUTTON_COLUMNS) && !defined(BUTTON_MATRIX_DMA)
     volatile uint8_t _activeInColumn;
 #endif
 
+#ifdef ENCODER_TIMERS
+    /// Counter of each encoder timer at the last sample.
+    /// Used only in interrupt to detect the counters which have moved.
+    uint16_t _encoderTimerSample[NUMBER_OF_ENCODER_TIMERS];
+
+    /// Counter of each encoder timer at the last read by application.
+    uint16_t _encoderTimerRead[NUMBER_OF_ENCODER_TIMERS];
+
+    /// Marks encoders whose hardware counter has moved as changed.
+    /// At high rotation speeds the pins can be in the same state at two consecutive samples
+    /// even though the counter has moved, so the pin readings alone aren't enough.
+    inline void checkEncoderTimers()
+    {
+        for (size_t i = 0; i < NUMBER_OF_ENCODER_TIMERS; i++)
+        {
+            const uint16_t count = Board::detail::io::encoderTimerCount(i);
+
+            if (count == _encoderTimerSample[i])
+                continue;
+
+            _encoderTimerSample[i] = count;
+
+            const size_t buttonIndex = Board::detail::map::buttonIndex(Board::io::encoderSignalIndex(Board::detail::map::encoderTimer(i).encoderIndex, Board::io::encoderIndex_t::a));
+            _digitalInChangedSample[buttonIndex / 32] |= (static_cast<uint32_t>(1) << (buttonIndex % 32));
+        }
+    }
+#endif
+
 #if defined(SR_IN_CLK_PORT) && defined(SR_IN_LATCH_PORT) && defined(SR_IN_DATA_PORT) && !defined(NUMBER_OF_BUTTON_COLUMNS) && !defined(NUMBER_OF_BUTTON_ROWS)
+#ifdef SR_IN_SPI
+    uint8_t           _srInBuffer[NUMBER_OF_IN_SR];
+    volatile bool     _srInTransferActive;
+    volatile uint32_t _srInSampleTime;
+
+    /// Latches the inputs and starts the readout of shift registers. Readings are stored
+    /// once the transfer is complete (see Board::detail::isrHandling::sr165).
+    inline void storeDigitalIn()
+    {
+        //don't latch new state while the previous one is still being shifted out
+        if (_srInTransferActive)
+            return;
+
+        CORE_IO_SET_LOW(SR_IN_LATCH_PORT, SR_IN_LATCH_PIN);
+        Board::detail::io::sr165wait();
+        CORE_IO_SET_HIGH(SR_IN_LATCH_PORT, SR_IN_LATCH_PIN);
+
+        _srInSampleTime     = _sampleTime;
+        _srInTransferActive = Board::detail::io::sr165readSPI(_srInBuffer, NUMBER_OF_IN_SR);
+    }
+#else
     inline void storeDigitalIn()
     {
         CORE_IO_SET_LOW(SR_IN_CLK_PORT, SR_IN_CLK_PIN);
@@ -52,17 +299,31 @@ namespace
                 CORE_IO_SET_LOW(SR_IN_CLK_PORT, SR_IN_CLK_PIN);
                 Board::detail::io::sr165wait();
 
-                _digitalInBuffer[buttonIndex].readings <<= 1;
-                _digitalInBuffer[buttonIndex].readings |= !CORE_IO_READ(SR_IN_DATA_PORT, SR_IN_DATA_PIN);
-
-                if (++_digitalInBuffer[buttonIndex].count > 32)
-                    _digitalInBuffer[buttonIndex].count = 32;
+                storeReading(buttonIndex, !CORE_IO_READ(SR_IN_DATA_PORT, SR_IN_DATA_PIN));
 
                 CORE_IO_SET_HIGH(SR_IN_CLK_PORT, SR_IN_CLK_PIN);
             }
         }
     }
+#endif
 #elif defined(NUMBER_OF_BUTTON_COLUMNS) && defined(NUMBER_OF_BUTTON_ROWS)
+#ifdef BUTTON_MATRIX_DMA
+    /// Acquires data for all buttons in matrix from the last frame scanned by DMA.
+    /// Columns are switched and rows read in background, so no waiting is needed here.
+    inline void storeDigitalIn()
+    {
+        const volatile uint16_t* frame = Board::detail::io::dInMatrixFrame();
+
+        for (int column = 0; column < NUMBER_OF_BUTTON_COLUMNS; column++)
+        {
+            //rows are active low
+            uint16_t rows = ~frame[column];
+
+            for (int row = 0; row < NUMBER_OF_BUTTON_ROWS; row++)
+                storeReading((row * 8) + column, (rows >> Board::detail::map::buttonMatrixRowBit(row)) & 0x01);
+        }
+    }
+#else
     inline void activateInputColumn()
     {
         BIT_READ(_activeInColumn, 0) ? CORE_IO_SET_HIGH(DEC_BM_PORT_A0, DEC_BM_PIN_A0) : CORE_IO_SET_LOW(DEC_BM_PORT_A0, DEC_BM_PIN_A0);
@@ -96,11 +357,7 @@ namespace
                 CORE_IO_SET_LOW(SR_IN_CLK_PORT, SR_IN_CLK_PIN);
                 Board::detail::io::sr165wait();
 
-                _digitalInBuffer[buttonIndex].readings <<= 1;
-                _digitalInBuffer[buttonIndex].readings |= !CORE_IO_READ(SR_IN_DATA_PORT, SR_IN_DATA_PIN);
-
-                if (++_digitalInBuffer[buttonIndex].count > 32)
-                    _digitalInBuffer[buttonIndex].count = 32;
+                storeReading(buttonIndex, !CORE_IO_READ(SR_IN_DATA_PORT, SR_IN_DATA_PIN));
 
                 CORE_IO_SET_HIGH(SR_IN_CLK_PORT, SR_IN_CLK_PIN);
             }
@@ -112,29 +369,27 @@ namespace
                 size_t buttonIndex = (row * 8) + column;
                 pin                = Board::detail::map::buttonPin(row);
 
-                _digitalInBuffer[buttonIndex].readings <<= 1;
-                _digitalInBuffer[buttonIndex].readings |= !CORE_IO_READ(CORE_IO_MCU_PIN_PORT(pin), CORE_IO_MCU_PIN_INDEX(pin));
-
-                if (++_digitalInBuffer[buttonIndex].count > 32)
-                    _digitalInBuffer[buttonIndex].count = 32;
+                storeReading(buttonIndex, !CORE_IO_READ(CORE_IO_MCU_PIN_PORT(pin), CORE_IO_MCU_PIN_INDEX(pin)));
             }
 #endif
         }
     }
+#endif
 #else
-    core::io::mcuPin_t _pin;
-
     inline void storeDigitalIn()
     {
-        for (int buttonIndex = 0; buttonIndex < MAX_NUMBER_OF_BUTTONS; buttonIndex++)
+        //read every port only once and distribute the pin states to all buttons on that port
+        for (int port = 0; port < NUMBER_OF_DIN_PORTS; port++)
         {
-            _pin = Board::detail::map::buttonPin(buttonIndex);
+            auto&    portDescriptor = Board::detail::map::buttonPort(port);
+            uint32_t states         = ~Board::detail::io::readPort(portDescriptor.port) & portDescriptor.mask;
 
-            _digitalInBuffer[buttonIndex].readings <<= 1;
-            _digitalInBuffer[buttonIndex].readings |= !CORE_IO_READ(CORE_IO_MCU_PIN_PORT(_pin), CORE_IO_MCU_PIN_INDEX(_pin));
+            for (int pin = 0; pin < portDescriptor.numberOfPins; pin++)
+            {
+                auto& portPin = Board::detail::map::buttonPortPin(portDescriptor.firstPin + pin);
 
-            if (++_digitalInBuffer[buttonIndex].count > 32)
-                _digitalInBuffer[buttonIndex].count = 32;
+                storeReading(portPin.buttonIndex, (states >> portPin.pinIndex) & 0x01);
+            }
         }
     }
 #endif
@@ -151,21 +406,88 @@ namespace Board
 
             digitalInIndex = detail::map::buttonIndex(digitalInIndex);
 
-            ATOMIC_SECTION
+            uint32_t readings;
+            uint32_t sample;
+
+            readReadings(digitalInIndex, readings, sample);
+
+            //debounced state is taken from the snapshot made in digitalInChanged
+            uint32_t newSamples = sample - _digitalInLastSample[digitalInIndex];
+
+            dInReadings.count     = newSamples > 32 ? 32 : newSamples;
+            dInReadings.readings  = readings;
+            dInReadings.debounced = (_digitalInSnapshot.debounced[digitalInIndex / 32] >> (digitalInIndex % 32)) & 0x01;
+
+            _digitalInLastSample[digitalInIndex] = sample;
+
+            return dInReadings.count > 0;
+        }
+
+        bool digitalInChanged(dInBitmap_t& changed)
+        {
+            bool anyChanged = false;
+
+            changed = {};
+
+            //single consistent copy of all inputs is used until the next poll
+            if (!_digitalInFrames.poll(_digitalInSnapshot))
+                return false;
+
+            changed = _digitalInSnapshot.changed;
+
+            for (size_t word = 0; word < changed.size(); word++)
             {
-                dInReadings.count                      = _digitalInBuffer[digitalInIndex].count;
-                dInReadings.readings                   = _digitalInBuffer[digitalInIndex].readings;
-                _digitalInBuffer[digitalInIndex].count = 0;
+                if (changed[word])
+                {
+                    anyChanged = true;
+                    break;
+                }
             }
 
-            return dInReadings.count > 0;
+#ifdef BUTTON_INDEXING
+            if (anyChanged)
+            {
+                //bitmap is stored using physical indexes - convert it to user-specified indexes
+                dInBitmap_t physical = changed;
+                changed              = {};
+
+                for (size_t i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+                {
+                    size_t physicalIndex = detail::map::buttonIndex(i);
+
+                    if ((physical[physicalIndex / 32] >> (physicalIndex % 32)) & 0x01)
+                        changed[i / 32] |= (static_cast<uint32_t>(1) << (i % 32));
+                }
+            }
+#endif
+
+            return anyChanged;
+        }
+
+        bool digitalInEdgeTime(size_t digitalInIndex, uint32_t& time)
+        {
+            if (digitalInIndex >= MAX_NUMBER_OF_BUTTONS)
+                return false;
+
+            digitalInIndex = detail::map::buttonIndex(digitalInIndex);
+
+            //time can change on every sample: retry if that happened during the read
+            uint8_t sequence;
+
+            do
+            {
+                sequence = _digitalInSampleSequence;
+                time     = _digitalInEdgeTime[digitalInIndex];
+            } while (sequence != _digitalInSampleSequence);
+
+            return true;
         }
 
         size_t encoderIndex(size_t buttonID)
         {
 #ifdef NUMBER_OF_BUTTON_COLUMNS
-            uint8_t row    = buttonID / NUMBER_OF_BUTTON_COLUMNS;
-            uint8_t column = buttonID % NUMBER_OF_BUTTON_COLUMNS;
+            size_t row    = buttonID / NUMBER_OF_BUTTON_COLUMNS;
+            size_t column = buttonID % NUMBER_OF_BUTTON_COLUMNS;
 
             if (row % 2)
                 row -= 1;    //uneven row, get info from previous (even) row
@@ -176,20 +498,50 @@ namespace Board
 #endif
         }
 
+#ifdef ENCODERS_SUPPORTED
+        bool encoderPulses(size_t encoderID, int16_t& pulses)
+        {
+            if (encoderID >= MAX_NUMBER_OF_ENCODERS)
+                return false;
+
+#ifdef ENCODER_TIMERS
+            for (size_t i = 0; i < NUMBER_OF_ENCODER_TIMERS; i++)
+            {
+                if (detail::map::encoderTimer(i).encoderIndex != encoderID)
+                    continue;
+
+                //counter wraps around, difference is still correct as long as it's read often enough
+                const uint16_t count = detail::io::encoderTimerCount(i);
+                pulses               = static_cast<int16_t>(count - _encoderTimerRead[i]);
+                _encoderTimerRead[i] = count;
+
+                return true;
+            }
+#endif
+
+            //counter wraps around just like the timer ones
+            const uint16_t count         = encoderPulseCount(encoderID);
+            pulses                       = static_cast<int16_t>(count - _encoderPulseRead[encoderID]);
+            _encoderPulseRead[encoderID] = count;
+
+            return true;
+        }
+#endif
+
         size_t encoderSignalIndex(size_t encoderID, encoderIndex_t index)
         {
 #ifdef NUMBER_OF_BUTTON_COLUMNS
-            uint8_t column = encoderID % NUMBER_OF_BUTTON_COLUMNS;
-            uint8_t row    = (encoderID / NUMBER_OF_BUTTON_COLUMNS) * 2;
+            size_t column = encoderID % NUMBER_OF_BUTTON_COLUMNS;
+            size_t row    = (encoderID / NUMBER_OF_BUTTON_COLUMNS) * 2;
 
-            uint8_t buttonID = row * NUMBER_OF_BUTTON_COLUMNS + column;
+            size_t buttonID = row * NUMBER_OF_BUTTON_COLUMNS + column;
 
             if (index == encoderIndex_t::a)
                 return buttonID;
             else
                 return buttonID + NUMBER_OF_BUTTON_COLUMNS;
 #else
-            uint8_t buttonID = encoderID * 2;
+            size_t buttonID = encoderID * 2;
 
             if (index == encoderIndex_t::a)
                 return buttonID;
@@ -205,17 +557,55 @@ namespace Board
         {
             void checkDigitalInputs()
             {
+                _sampleTime += SAMPLE_PERIOD_US;
                 storeDigitalIn();
+
+#ifdef ENCODER_TIMERS
+                checkEncoderTimers();
+#endif
+
+#ifndef SR_IN_SPI
+                //with SPI readout, readings are processed once the transfer is complete
+                processDigitalIn(_sampleTime);
+#endif
             }
 
             void flushInputReadings()
             {
-                ATOMIC_SECTION
+                //mark everything sampled so far as already read
+                Board::io::dInBitmap_t changed;
+                Board::io::digitalInChanged(changed);
+
+                for (size_t i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
                 {
-                    for (size_t i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
-                        _digitalInBuffer[i].count = 0;
+                    uint32_t readings;
+                    readReadings(i, readings, _digitalInLastSample[i]);
                 }
+
+#ifdef ENCODERS_SUPPORTED
+                //discard the pulses decoded from initial readout
+                for (size_t i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+                    _encoderPulseRead[i] = encoderPulseCount(i);
+#endif
             }
         }    // namespace io
+
+#ifdef SR_IN_SPI
+        namespace isrHandling
+        {
+            void sr165()
+            {
+                for (int shiftRegister = 0; shiftRegister < NUMBER_OF_IN_SR; shiftRegister++)
+                {
+                    //register shifts out MSB first which is also the order in which SPI receives the data
+                    for (int input = 0; input < 8; input++)
+                        storeReading((shiftRegister * 8) + input, !((_srInBuffer[shiftRegister] >> input) & 0x01));
+                }
+
+                processDigitalIn(_srInSampleTime);
+                _srInTransferActive = false;
+            }
+        }    // namespace isrHandling
+#endif
     }        // namespace detail
 }    // namespace Board
\ No newline at end of file
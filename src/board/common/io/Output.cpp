@@ -72,7 +72,7 @@ namespace Board
             {
                 for (int i = 0; i < static_cast<int>(ledBrightness_t::b100); i++)
                 {
-                    uint8_t arrayIndex = ledID / 8;
+                    size_t  arrayIndex = ledID / 8;
                     uint8_t ledBit     = ledID - 8 * arrayIndex;
 
                     BIT_WRITE(_ledState[arrayIndex][i], ledBit, i < static_cast<int>(ledBrightness) ? 1 : 0);
@@ -83,9 +83,9 @@ namespace Board
         size_t rgbSignalIndex(size_t rgbID, Board::io::rgbIndex_t index)
         {
 #ifdef NUMBER_OF_LED_COLUMNS
-            uint8_t column  = rgbID % NUMBER_OF_LED_COLUMNS;
-            uint8_t row     = (rgbID / NUMBER_OF_LED_COLUMNS) * 3;
-            uint8_t address = column + NUMBER_OF_LED_COLUMNS * row;
+            size_t column  = rgbID % NUMBER_OF_LED_COLUMNS;
+            size_t row     = (rgbID / NUMBER_OF_LED_COLUMNS) * 3;
+            size_t address = column + NUMBER_OF_LED_COLUMNS * row;
 
             switch (index)
             {
@@ -108,21 +108,21 @@ namespace Board
         size_t rgbIndex(size_t ledID)
         {
 #ifdef NUMBER_OF_LED_COLUMNS
-            uint8_t row = ledID / NUMBER_OF_LED_COLUMNS;
+            size_t row = ledID / NUMBER_OF_LED_COLUMNS;
 
-            uint8_t mod = row % 3;
+            size_t mod = row % 3;
             row -= mod;
 
-            uint8_t column = ledID % NUMBER_OF_LED_COLUMNS;
+            size_t column = ledID % NUMBER_OF_LED_COLUMNS;
 
-            uint8_t result = (row * NUMBER_OF_LED_COLUMNS) / 3 + column;
+            size_t result = (row * NUMBER_OF_LED_COLUMNS) / 3 + column;
 
             if (result >= MAX_NUMBER_OF_RGB_LEDS)
                 return MAX_NUMBER_OF_RGB_LEDS - 1;
             else
                 return result;
 #else
-            uint8_t result = ledID / 3;
+            size_t result = ledID / 3;
 
             if (result >= MAX_NUMBER_OF_RGB_LEDS)
                 return MAX_NUMBER_OF_RGB_LEDS - 1;
@@ -181,7 +181,7 @@ namespace Board
                 for (int i = 0; i < NUMBER_OF_LED_ROWS; i++)
                 {
                     size_t  ledID      = activeOutColumn + i * NUMBER_OF_LED_COLUMNS;
-                    uint8_t arrayIndex = ledID / 8;
+                    size_t  arrayIndex = ledID / 8;
                     uint8_t ledBit     = ledID - 8 * arrayIndex;
 
                     BIT_READ(_ledState[arrayIndex][_pwmCounter], ledBit) ? ledRowOn(i) : ledRowOff(i);
@@ -197,7 +197,7 @@ namespace Board
                     for (int i = 0; i < 8; i++)
                     {
                         size_t  ledID      = i + j * 8;
-                        uint8_t arrayIndex = ledID / 8;
+                        size_t  arrayIndex = ledID / 8;
                         uint8_t ledBit     = ledID - 8 * arrayIndex;
 
                         BIT_READ(_ledState[arrayIndex][_pwmCounter], ledBit) ? EXT_LED_ON(SR_OUT_DATA_PORT, SR_OUT_DATA_PIN) : EXT_LED_OFF(SR_OUT_DATA_PORT, SR_OUT_DATA_PIN);
@@ -217,7 +217,7 @@ namespace Board
             {
                 for (size_t ledID = 0; ledID < MAX_NUMBER_OF_LEDS; ledID++)
                 {
-                    uint8_t arrayIndex = ledID / 8;
+                    size_t  arrayIndex = ledID / 8;
                     uint8_t ledBit     = ledID - 8 * arrayIndex;
 
                     core::io::mcuPin_t pin = Board::detail::map::ledPin(ledID);
@@ -0,0 +1,62 @@
+/*
+
+Copyright 2015-2021 Igor Petrovic
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+*/
+
+#pragma once
+
+#include <inttypes.h>
+
+namespace Board
+{
+    namespace detail
+    {
+        namespace io
+        {
+            /// Lookup table used to convert previous and current A and B signal readings to pulses.
+            /// Index is made of previous readings in upper two bits and current readings in lower
+            /// two bits, with A signal in higher bit of each pair.
+            constexpr int8_t QUADRATURE_LOOKUP_TABLE[16] = {
+                0,     //0000
+                -1,    //0001
+                1,     //0010
+                0,     //0011
+                1,     //0100
+                0,     //0101
+                0,     //0110
+                -1,    //0111
+                -1,    //1000
+                0,     //1001
+                0,     //1010
+                1,     //1011
+                0,     //1100
+                1,     //1101
+                -1,    //1110
+                0      //1111
+            };
+
+            /// Decodes the pulse between the last two readings of encoder signals.
+            /// param [in]: readingsA   Reading history of A signal, newest in LSB bit.
+            /// param [in]: readingsB   Reading history of B signal, newest in LSB bit.
+            /// returns: 1 on clockwise pulse, -1 on counter-clockwise pulse, 0 otherwise.
+            inline int8_t quadraturePulse(uint32_t readingsA, uint32_t readingsB)
+            {
+                //previous reading of each signal is still available in reading history
+                return QUADRATURE_LOOKUP_TABLE[((readingsA & 0x02) << 2) | ((readingsB & 0x02) << 1) | ((readingsA & 0x01) << 1) | (readingsB & 0x01)];
+            }
+        }    // namespace io
+    }        // namespace detail
+}    // namespace Board
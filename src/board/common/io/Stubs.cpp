@@ -31,6 +31,21 @@ namespace Board
             return false;
         }
 
+        __attribute__((weak)) bool digitalInChanged(dInBitmap_t& changed)
+        {
+            return false;
+        }
+
+        __attribute__((weak)) bool digitalInEdgeTime(size_t digitalInIndex, uint32_t& time)
+        {
+            return false;
+        }
+
+        __attribute__((weak)) bool digitalInScanTime(dInScanTime_t& scanTime)
+        {
+            return false;
+        }
+
         __attribute__((weak)) size_t encoderIndex(size_t buttonID)
         {
             return 0;
@@ -41,6 +56,11 @@ namespace Board
             return 0;
         }
 
+        __attribute__((weak)) bool encoderPulses(size_t encoderID, int16_t& pulses)
+        {
+            return false;
+        }
+
         __attribute__((weak)) void writeLEDstate(size_t ledID, bool state)
         {
         }
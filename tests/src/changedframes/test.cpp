@@ -0,0 +1,125 @@
+#include "unity/Framework.h"
+#include "board/common/io/ChangedFrames.h"
+#include <array>
+#include <functional>
+
+namespace
+{
+    constexpr size_t WORDS = 2;
+
+    /// Number of bitmaps copied so far.
+    size_t _copies;
+
+    /// Called in the middle of bitmap copy to simulate interrupt in which the writer runs.
+    std::function<void()> _interrupt;
+
+    struct bitmap_t : public std::array<uint32_t, WORDS>
+    {
+        bitmap_t& operator=(const bitmap_t& other)
+        {
+            for (size_t i = 0; i < WORDS; i++)
+            {
+                (*this)[i] = other[i];
+
+                if ((i == 0) && _interrupt)
+                {
+                    auto interrupt = _interrupt;
+                    _interrupt     = nullptr;
+                    interrupt();
+                }
+            }
+
+            _copies++;
+            return *this;
+        }
+    };
+
+    Board::detail::io::ChangedFrames<bitmap_t>* frames = nullptr;
+
+    /// Runs single sample in which specified inputs in the first word have changed.
+    bool sample(uint32_t changed, uint32_t debounced = 0)
+    {
+        frames->begin();
+        frames->store(0, debounced, changed);
+        frames->store(1, 0, 0);
+
+        return frames->end();
+    }
+}    // namespace
+
+TEST_SETUP()
+{
+    delete frames;
+
+    frames     = new Board::detail::io::ChangedFrames<bitmap_t>();
+    _interrupt = nullptr;
+    _copies    = 0;
+}
+
+TEST_CASE(IdlePollsDontCopy)
+{
+    Board::detail::io::ChangedFrames<bitmap_t>::frame_t frame;
+
+    //nothing has been published yet
+    TEST_ASSERT(frames->poll(frame) == false);
+
+    TEST_ASSERT(sample(0x01, 0x01) == true);
+
+    size_t copies = _copies;
+    TEST_ASSERT(frames->poll(frame) == true);
+    TEST_ASSERT(_copies > copies);
+    TEST_ASSERT_EQUAL_UINT32(0x01, frame.changed[0]);
+    TEST_ASSERT_EQUAL_UINT32(0x01, frame.debounced[0]);
+
+    //once the changes are acknowledged, samples without changes aren't published
+    copies = _copies;
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        TEST_ASSERT(sample(0, 0x01) == false);
+        TEST_ASSERT(frames->poll(frame) == false);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(copies, _copies);
+}
+
+TEST_CASE(ChangesKeptUntilAcknowledged)
+{
+    Board::detail::io::ChangedFrames<bitmap_t>::frame_t frame;
+
+    //changes from several samples are merged until the reader polls
+    sample(0x01);
+    sample(0);
+    sample(0x04);
+
+    TEST_ASSERT(frames->poll(frame) == true);
+    TEST_ASSERT_EQUAL_UINT32(0x05, frame.changed[0]);
+
+    //acknowledged changes are dropped
+    TEST_ASSERT(sample(0x08) == true);
+    TEST_ASSERT(frames->poll(frame) == true);
+    TEST_ASSERT_EQUAL_UINT32(0x08, frame.changed[0]);
+}
+
+TEST_CASE(PublishDuringPoll)
+{
+    Board::detail::io::ChangedFrames<bitmap_t>::frame_t frame;
+
+    sample(0x01);
+
+    //writer publishes new change while the reader copies the frame
+    _interrupt = []() {
+        sample(0x02);
+    };
+
+    TEST_ASSERT(frames->poll(frame) == true);
+    TEST_ASSERT_EQUAL_UINT32(0x01, frame.changed[0]);
+
+    //reader has acknowledged older frame so the new change is still reported
+    TEST_ASSERT(sample(0) == true);
+    TEST_ASSERT(frames->poll(frame) == true);
+    TEST_ASSERT(frame.changed[0] & 0x02);
+
+    TEST_ASSERT(sample(0) == false);
+    TEST_ASSERT(frames->poll(frame) == false);
+}
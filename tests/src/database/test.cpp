@@ -68,6 +68,36 @@ TEST_CASE(ReadInitialValues)
         for (int i = 0; i < MAX_NUMBER_OF_BUTTONS + MAX_NUMBER_OF_ANALOG + MAX_NUMBER_OF_TOUCHSCREEN_COMPONENTS; i++)
             TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::button_t::midiChannel, i));
 
+        //dual contact velocity curve section
+        //all values should be set to default curve
+        for (size_t i = 0; i < IO::Buttons::DUAL_CONTACT_CURVE_POINTS; i++)
+            TEST_ASSERT_EQUAL_UINT32(IO::Buttons::DUAL_CONTACT_CURVE_DEFAULT[i], database.read(Database::Section::button_t::dualContactCurve, i));
+
+        //debounce profile section
+        //all values should be set to 0 (board)
+        for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::button_t::debounceProfile, i));
+
+        //debounce press samples section
+        //all values should be set to 1
+        for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+            TEST_ASSERT_EQUAL_UINT32(1, database.read(Database::Section::button_t::debouncePressSamples, i));
+
+        //debounce release samples section
+        //all values should be set to 5
+        for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+            TEST_ASSERT_EQUAL_UINT32(5, database.read(Database::Section::button_t::debounceReleaseSamples, i));
+
+        //gesture sections
+        //all values should be set to 0 (gestures disabled)
+        for (size_t i = 0; i < IO::Buttons::GESTURE_BUTTONS; i++)
+        {
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::button_t::gestureLongPressTime, i));
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::button_t::gestureDoubleTapTime, i));
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::button_t::gestureRepeatTime, i));
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::button_t::gestureMidiID, i));
+        }
+
         //encoders block
         //----------------------------------
         //enable section
@@ -100,6 +130,21 @@ TEST_CASE(ReadInitialValues)
         for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
             TEST_ASSERT_EQUAL_UINT32(4, database.read(Database::Section::encoder_t::pulsesPerStep, i));
 
+        //acceleration curve section
+        //all values should be set to default curves
+        for (size_t i = 0; i < IO::Encoders::ACCELERATION_CURVES * IO::Encoders::ACCELERATION_CURVE_POINTS; i++)
+            TEST_ASSERT_EQUAL_UINT32(IO::Encoders::ACCELERATION_CURVE_DEFAULT[i], database.read(Database::Section::encoder_t::accelerationCurve, i));
+
+        //stored value section
+        //all values should be set to 0
+        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::encoder_t::value, i));
+
+        //value stored section
+        //no value should be stored
+        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+            TEST_ASSERT_EQUAL_UINT32(0, database.read(Database::Section::encoder_t::valueStored, i));
+
         //analog block
         //----------------------------------
         //enable section
@@ -354,6 +399,34 @@ TEST_CASE(FactoryReset)
     TEST_ASSERT(database.getPresetPreserveState() == false);
 }
 
+TEST_CASE(Revision)
+{
+    //init checks - no point in running further tests if these conditions fail
+    TEST_ASSERT(database.init() == true);
+
+    //revision should change on every write and preset change
+    uint32_t revision = database.revision();
+
+    TEST_ASSERT(database.update(Database::Section::global_t::midiFeatures, 0, 1) == true);
+    TEST_ASSERT(database.revision() != revision);
+    revision = database.revision();
+
+    if (database.getSupportedPresets() > 1)
+    {
+        TEST_ASSERT(database.setPreset(1) == true);
+        TEST_ASSERT(database.revision() != revision);
+        revision = database.revision();
+
+        TEST_ASSERT(database.setPreset(0) == true);
+        TEST_ASSERT(database.revision() != revision);
+        revision = database.revision();
+    }
+
+    //reads shouldn't change the revision
+    database.read(Database::Section::global_t::midiFeatures, 0);
+    TEST_ASSERT(database.revision() == revision);
+}
+
 #if MAX_NUMBER_OF_LEDS > 0
 TEST_CASE(LEDs)
 {
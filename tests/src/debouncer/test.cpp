@@ -0,0 +1,295 @@
+#include "unity/Framework.h"
+#include "board/common/io/Debouncer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    constexpr uint8_t PRESS_SAMPLES   = 2;
+    constexpr uint8_t RELEASE_SAMPLES = 5;
+
+    /// Reference debouncer which processes single input at a time.
+    class ScalarDebouncer
+    {
+        public:
+        bool update(bool sample)
+        {
+            if (sample == _state)
+            {
+                _counter = 0;
+                return false;
+            }
+
+            if (++_counter < (_state ? RELEASE_SAMPLES : PRESS_SAMPLES))
+                return false;
+
+            _state   = sample;
+            _counter = 0;
+
+            return true;
+        }
+
+        bool state() const
+        {
+            return _state;
+        }
+
+        private:
+        bool    _state   = false;
+        uint8_t _counter = 0;
+    };
+
+    /// Replica of the per-button path used before vertical counters: reading history
+    /// is stored per input and each input is then checked separately.
+    template<size_t inputs>
+    class PerButtonPath
+    {
+        public:
+        void sample(size_t index, bool state)
+        {
+            _readings[index].readings <<= 1;
+            _readings[index].readings |= state;
+
+            if (++_readings[index].count > 32)
+                _readings[index].count = 32;
+        }
+
+        size_t process()
+        {
+            size_t changes = 0;
+
+            for (size_t i = 0; i < inputs; i++)
+            {
+                uint8_t  count  = _readings[i].count;
+                uint32_t states = _readings[i].readings;
+
+                _readings[i].count = 0;
+
+                if (!count)
+                    continue;
+
+                states &= 0x03;
+
+                if (count >= 2)
+                    states = states ? 0x01 : 0x00;
+                else
+                    states &= 0x01;
+
+                if (static_cast<bool>(states) != _state[i])
+                {
+                    _state[i] = states;
+                    changes++;
+                }
+            }
+
+            return changes;
+        }
+
+        private:
+        struct
+        {
+            uint8_t  count;
+            uint32_t readings;
+        } _readings[inputs] = {};
+
+        bool _state[inputs] = {};
+    };
+
+    template<size_t inputs>
+    size_t processChanges(Board::detail::io::Debouncer<inputs>& debouncer)
+    {
+        size_t changes = 0;
+
+        for (size_t word = 0; word < Board::detail::io::Debouncer<inputs>::WORDS; word++)
+        {
+            uint32_t changed = debouncer.changedWord(word);
+
+            while (changed)
+            {
+                changed &= changed - 1;
+                changes++;
+            }
+        }
+
+        return changes;
+    }
+
+    /// Generates pseudo-random samples in which few inputs are bouncing at any given time.
+    bool bouncySample(size_t index, size_t iteration)
+    {
+        static uint32_t seed = 1;
+        seed                 = seed * 1103515245 + 12345;
+
+        bool stable = ((iteration / 64) + index) % 2;
+
+        //roughly one in eight samples is noise
+        if (((seed >> 16) & 0x07) == 0)
+            return !stable;
+
+        return stable;
+    }
+
+    template<size_t inputs>
+    void benchmark(size_t iterations)
+    {
+        static Board::detail::io::Debouncer<inputs> debouncer(PRESS_SAMPLES, RELEASE_SAMPLES);
+        static PerButtonPath<inputs>                perButton;
+        static bool                                 samples[1024][inputs];
+
+        for (size_t i = 0; i < 1024; i++)
+        {
+            for (size_t input = 0; input < inputs; input++)
+                samples[i][input] = bouncySample(input, i);
+        }
+
+        size_t changes = 0;
+        auto   start   = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < iterations; i++)
+        {
+            for (size_t input = 0; input < inputs; input++)
+                perButton.sample(input, samples[i % 1024][input]);
+
+            changes += perButton.process();
+        }
+
+        auto perButtonTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+
+        //inputs are sampled one by one in both paths, as in input timer interrupt
+        for (size_t i = 0; i < iterations; i++)
+        {
+            for (size_t input = 0; input < inputs; input++)
+                debouncer.sample(input, samples[i % 1024][input]);
+
+            debouncer.update();
+            changes += processChanges(debouncer);
+        }
+
+        auto verticalTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        printf("%zu inputs: per-button path: %.1f ns/scan, vertical counters: %.1f ns/scan (%zu changes)\n",
+               inputs,
+               static_cast<double>(perButtonTime) / iterations,
+               static_cast<double>(verticalTime) / iterations,
+               changes);
+    }
+}    // namespace
+
+TEST_CASE(PressAndReleaseThresholds)
+{
+    Board::detail::io::Debouncer<8> debouncer(PRESS_SAMPLES, RELEASE_SAMPLES);
+
+    //single sample isn't enough to register the press
+    debouncer.sample(3, true);
+    debouncer.update();
+    TEST_ASSERT(debouncer.state(3) == false);
+    TEST_ASSERT_EQUAL_UINT32(0, debouncer.changedWord(0));
+
+    debouncer.update();
+    TEST_ASSERT(debouncer.state(3) == true);
+    TEST_ASSERT_EQUAL_UINT32(1 << 3, debouncer.changedWord(0));
+
+    //change mask is cleared once read
+    TEST_ASSERT_EQUAL_UINT32(0, debouncer.changedWord(0));
+
+    debouncer.sample(3, false);
+
+    for (size_t i = 0; i < RELEASE_SAMPLES - 1; i++)
+    {
+        debouncer.update();
+        TEST_ASSERT(debouncer.state(3) == true);
+    }
+
+    debouncer.update();
+    TEST_ASSERT(debouncer.state(3) == false);
+    TEST_ASSERT_EQUAL_UINT32(1 << 3, debouncer.changedWord(0));
+}
+
+TEST_CASE(BounceRejection)
+{
+    Board::detail::io::Debouncer<8> debouncer(PRESS_SAMPLES, RELEASE_SAMPLES);
+
+    //alternating samples never reach the threshold
+    for (size_t i = 0; i < 32; i++)
+    {
+        debouncer.sample(0, i % 2);
+        debouncer.update();
+        TEST_ASSERT(debouncer.state(0) == false);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, debouncer.changedWord(0));
+
+    debouncer.sample(0, true);
+    debouncer.update();
+    debouncer.update();
+    TEST_ASSERT(debouncer.state(0) == true);
+
+    //short release glitches are ignored
+    for (size_t i = 0; i < 32; i++)
+    {
+        debouncer.sample(0, (i % RELEASE_SAMPLES) != 0);
+        debouncer.update();
+        TEST_ASSERT(debouncer.state(0) == true);
+    }
+}
+
+TEST_CASE(ThresholdLimits)
+{
+    Board::detail::io::Debouncer<8> debouncer(0, 0xFF);
+
+    //zero threshold is treated as immediate change
+    debouncer.sample(1, true);
+    debouncer.update();
+    TEST_ASSERT(debouncer.state(1) == true);
+
+    debouncer.sample(1, false);
+
+    for (size_t i = 0; i < Board::detail::io::Debouncer<8>::MAX_THRESHOLD - 1; i++)
+    {
+        debouncer.update();
+        TEST_ASSERT(debouncer.state(1) == true);
+    }
+
+    debouncer.update();
+    TEST_ASSERT(debouncer.state(1) == false);
+}
+
+TEST_CASE(MatchesScalarDebouncer)
+{
+    constexpr size_t INPUTS = 100;
+
+    static Board::detail::io::Debouncer<INPUTS> debouncer(PRESS_SAMPLES, RELEASE_SAMPLES);
+    ScalarDebouncer                             reference[INPUTS];
+
+    for (size_t iteration = 0; iteration < 2000; iteration++)
+    {
+        uint32_t expectedChanges[Board::detail::io::Debouncer<INPUTS>::WORDS] = {};
+
+        for (size_t input = 0; input < INPUTS; input++)
+        {
+            bool sample = bouncySample(input, iteration);
+
+            debouncer.sample(input, sample);
+
+            if (reference[input].update(sample))
+                expectedChanges[input / 32] |= static_cast<uint32_t>(1) << (input % 32);
+        }
+
+        debouncer.update();
+
+        for (size_t input = 0; input < INPUTS; input++)
+            TEST_ASSERT(debouncer.state(input) == reference[input].state());
+
+        for (size_t word = 0; word < Board::detail::io::Debouncer<INPUTS>::WORDS; word++)
+            TEST_ASSERT_EQUAL_UINT32(expectedChanges[word], debouncer.changedWord(word));
+    }
+}
+
+TEST_CASE(Benchmark)
+{
+    benchmark<128>(100000);
+    benchmark<256>(100000);
+}
@@ -0,0 +1,118 @@
+#include "unity/Framework.h"
+#include "board/common/io/DoubleBuffer.h"
+#include <functional>
+
+namespace
+{
+    constexpr size_t FRAME_SIZE = 8;
+
+    /// Called in the middle of frame copy to simulate interrupt in which the writer runs.
+    std::function<void()> _interrupt;
+
+    struct frame_t
+    {
+        uint32_t values[FRAME_SIZE];
+
+        frame_t& operator=(const frame_t& other)
+        {
+            for (size_t i = 0; i < FRAME_SIZE; i++)
+            {
+                values[i] = other.values[i];
+
+                if ((i == (FRAME_SIZE / 2)) && _interrupt)
+                {
+                    auto interrupt = _interrupt;
+                    _interrupt     = nullptr;
+                    interrupt();
+                }
+            }
+
+            return *this;
+        }
+
+        bool consistent() const
+        {
+            for (size_t i = 1; i < FRAME_SIZE; i++)
+            {
+                if (values[i] != values[0])
+                    return false;
+            }
+
+            return true;
+        }
+    };
+
+    Board::detail::io::DoubleBuffer<frame_t>* buffer = nullptr;
+
+    /// Builds the next frame from the previous one and publishes it.
+    void write()
+    {
+        auto& back = buffer->back();
+
+        for (size_t i = 0; i < FRAME_SIZE; i++)
+            back.values[i] = buffer->front().values[i] + 1;
+
+        buffer->publish();
+    }
+}    // namespace
+
+TEST_SETUP()
+{
+    delete buffer;
+
+    buffer     = new Board::detail::io::DoubleBuffer<frame_t>();
+    _interrupt = nullptr;
+}
+
+TEST_CASE(Publish)
+{
+    frame_t frame;
+
+    TEST_ASSERT_EQUAL_UINT8(0, buffer->read(frame));
+    TEST_ASSERT_EQUAL_UINT32(0, frame.values[0]);
+
+    for (uint32_t i = 1; i <= 300; i++)
+    {
+        write();
+
+        TEST_ASSERT_EQUAL_UINT8(i & 0xFF, buffer->read(frame));
+        TEST_ASSERT(frame.consistent());
+        TEST_ASSERT_EQUAL_UINT32(i, frame.values[0]);
+    }
+}
+
+TEST_CASE(SinglePublishDuringRead)
+{
+    frame_t frame;
+
+    write();
+
+    //writer fills the other frame so the one being copied stays intact
+    _interrupt = []() {
+        write();
+    };
+
+    TEST_ASSERT_EQUAL_UINT8(1, buffer->read(frame));
+    TEST_ASSERT(frame.consistent());
+    TEST_ASSERT_EQUAL_UINT32(1, frame.values[0]);
+
+    TEST_ASSERT_EQUAL_UINT8(2, buffer->read(frame));
+    TEST_ASSERT_EQUAL_UINT32(2, frame.values[0]);
+}
+
+TEST_CASE(DoublePublishDuringRead)
+{
+    frame_t frame;
+
+    write();
+
+    //second publish overwrites the frame being copied: read must be retried
+    _interrupt = []() {
+        write();
+        write();
+    };
+
+    TEST_ASSERT_EQUAL_UINT8(3, buffer->read(frame));
+    TEST_ASSERT(frame.consistent());
+    TEST_ASSERT_EQUAL_UINT32(3, frame.values[0]);
+}
@@ -33,13 +33,26 @@ namespace
         public:
         HWAButtons() {}
 
-        bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) override
+        bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states, bool& debounced) override
         {
             numberOfReadings = 1;
             states           = _state[index];
+            debounced        = _state[index];
             return true;
         }
 
+        bool changed(IO::Buttons::changedBitmap_t& bitmap) override
+        {
+            //report all buttons as changed so that every state is processed
+            bitmap.fill(0xFFFFFFFF);
+            return true;
+        }
+
+        bool edgeTime(size_t index, uint32_t& time) override
+        {
+            return false;
+        }
+
         bool _state[MAX_NUMBER_OF_BUTTONS] = {};
     } _hwaButtons;
 
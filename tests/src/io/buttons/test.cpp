@@ -17,14 +17,29 @@ namespace
         public:
         HWAButtons() {}
 
-        bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) override
+        bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states, bool& debounced) override
         {
             numberOfReadings = 1;
             states           = _state[index];
+            debounced        = _state[index];
             return true;
         }
 
-        bool _state[MAX_NUMBER_OF_BUTTONS] = {};
+        bool changed(IO::Buttons::changedBitmap_t& bitmap) override
+        {
+            //report all buttons as changed so that every state is processed
+            bitmap.fill(0xFFFFFFFF);
+            return true;
+        }
+
+        bool edgeTime(size_t index, uint32_t& time) override
+        {
+            time = _edgeTime[index];
+            return true;
+        }
+
+        bool     _state[MAX_NUMBER_OF_BUTTONS]    = {};
+        uint32_t _edgeTime[MAX_NUMBER_OF_BUTTONS] = {};
     } _hwaButtons;
 
     Util::MessageDispatcher _dispatcher;
@@ -715,6 +730,206 @@ TEST_CASE(LocalLEDcontrol)
 }
 #endif
 
+#if MAX_NUMBER_OF_BUTTONS > 1
+TEST_CASE(DualContact)
+{
+    using namespace IO;
+
+    //first contact is button 0, second contact is button 1
+    TEST_ASSERT(_database.update(Database::Section::button_t::type, 0, Buttons::type_t::dualContact) == true);
+    TEST_ASSERT(_database.update(Database::Section::button_t::midiMessage, 0, Buttons::messageType_t::note) == true);
+
+    auto setContact = [&](size_t index, bool state, uint32_t time) {
+        _listener._dispatchMessage.clear();
+        _hwaButtons._state[index]    = state;
+        _hwaButtons._edgeTime[index] = time;
+        _buttons.update();
+    };
+
+    auto press = [&](uint32_t time) {
+        _buttons.reset(0);
+        _buttons.reset(1);
+
+        //nothing should be sent until the second contact closes
+        setContact(0, true, 1000);
+        TEST_ASSERT_EQUAL_UINT32(0, _listener._dispatchMessage.size());
+
+        setContact(1, true, 1000 + time);
+        TEST_ASSERT_EQUAL_UINT32(1, _listener._dispatchMessage.size());
+        TEST_ASSERT_EQUAL_UINT32(MIDI::messageType_t::noteOn, _listener._dispatchMessage.at(0).message);
+        TEST_ASSERT_EQUAL_UINT32(0, _listener._dispatchMessage.at(0).midiIndex);
+
+        uint8_t velocity = _listener._dispatchMessage.at(0).midiValue;
+
+        //opening of the second contact alone shouldn't stop the note
+        setContact(1, false, 0);
+        TEST_ASSERT_EQUAL_UINT32(0, _listener._dispatchMessage.size());
+
+        setContact(0, false, 0);
+        TEST_ASSERT_EQUAL_UINT32(1, _listener._dispatchMessage.size());
+        TEST_ASSERT_EQUAL_UINT32(MIDI::messageType_t::noteOff, _listener._dispatchMessage.at(0).message);
+        TEST_ASSERT_EQUAL_UINT32(0, _listener._dispatchMessage.at(0).midiValue);
+
+        return velocity;
+    };
+
+    //faster than the first curve point
+    TEST_ASSERT_EQUAL_UINT32(127, press(1000));
+
+    //exactly on the curve points
+    TEST_ASSERT_EQUAL_UINT32(127, press(2000));
+    TEST_ASSERT_EQUAL_UINT32(109, press(4000));
+
+    //halfway between second (4 ms, velocity 109) and third (7 ms, velocity 91) point
+    TEST_ASSERT_EQUAL_UINT32(100, press(5500));
+
+    //slower than the last curve point
+    TEST_ASSERT_EQUAL_UINT32(1, press(100000));
+
+    //velocity should always decrease with longer times
+    uint8_t previousVelocity = 127;
+
+    for (uint32_t time = 0; time < 50000; time += 250)
+    {
+        uint8_t velocity = press(time);
+        TEST_ASSERT(velocity <= previousVelocity);
+        previousVelocity = velocity;
+    }
+
+    //dual contact button which doesn't send notes should behave as momentary button
+    TEST_ASSERT(_database.update(Database::Section::button_t::midiMessage, 0, Buttons::messageType_t::controlChangeReset) == true);
+    _buttons.reset(0);
+    _buttons.reset(1);
+
+    setContact(0, true, 0);
+    TEST_ASSERT_EQUAL_UINT32(1, _listener._dispatchMessage.size());
+    TEST_ASSERT_EQUAL_UINT32(MIDI::messageType_t::controlChange, _listener._dispatchMessage.at(0).message);
+
+    setContact(0, false, 0);
+}
+#endif
+
+#ifdef BUTTON_GESTURES
+TEST_CASE(Gestures)
+{
+    using namespace IO;
+
+    const size_t  index     = 0;
+    const uint8_t gestureID = 100;
+
+    auto setButton = [&](bool state) {
+        _listener._dispatchMessage.clear();
+        _hwaButtons._state[index] = state;
+        _buttons.update();
+    };
+
+    auto wait = [&](uint32_t time) {
+        _listener._dispatchMessage.clear();
+        core::timing::detail::rTime_ms += time;
+        _buttons.update();
+    };
+
+    auto verifyGesture = [&](MIDI::messageType_t message) {
+        TEST_ASSERT_EQUAL_UINT32(1, _listener._dispatchMessage.size());
+        TEST_ASSERT_EQUAL_UINT32(message, _listener._dispatchMessage.at(0).message);
+        TEST_ASSERT_EQUAL_UINT32(gestureID, _listener._dispatchMessage.at(0).midiIndex);
+    };
+
+    for (int i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+        _hwaButtons._state[i] = false;
+
+    TEST_ASSERT(_database.update(Database::Section::button_t::type, index, Buttons::type_t::momentary) == true);
+    TEST_ASSERT(_database.update(Database::Section::button_t::midiMessage, index, Buttons::messageType_t::note) == true);
+    TEST_ASSERT(_database.update(Database::Section::button_t::gestureMidiID, index, gestureID) == true);
+    TEST_ASSERT(_database.update(Database::Section::button_t::gestureLongPressTime, index, 50) == true);
+    TEST_ASSERT(_database.update(Database::Section::button_t::gestureDoubleTapTime, index, 30) == true);
+    _buttons.reset(index);
+
+    //long press: regular note on immediately, gesture note on after 500 ms
+    setButton(true);
+    TEST_ASSERT_EQUAL_UINT32(1, _listener._dispatchMessage.size());
+    TEST_ASSERT_EQUAL_UINT32(index, _listener._dispatchMessage.at(0).midiIndex);
+
+    wait(490);
+    TEST_ASSERT_EQUAL_UINT32(0, _listener._dispatchMessage.size());
+
+    wait(10);
+    verifyGesture(MIDI::messageType_t::noteOn);
+
+    //release ends both the regular note and the gesture, no double tap after long press
+    setButton(false);
+    TEST_ASSERT_EQUAL_UINT32(2, _listener._dispatchMessage.size());
+    TEST_ASSERT_EQUAL_UINT32(MIDI::messageType_t::noteOff, _listener._dispatchMessage.at(0).message);
+    TEST_ASSERT_EQUAL_UINT32(MIDI::messageType_t::noteOff, _listener._dispatchMessage.at(1).message);
+    TEST_ASSERT_EQUAL_UINT32(gestureID, _listener._dispatchMessage.at(1).midiIndex);
+
+    setButton(true);
+    TEST_ASSERT_EQUAL_UINT32(1, _listener._dispatchMessage.size());
+    setButton(false);
+    TEST_ASSERT_EQUAL_UINT32(1, _listener._dispatchMessage.size());
+
+    //double tap: second press within 300 ms
+    wait(200);
+    setButton(true);
+    TEST_ASSERT_EQUAL_UINT32(2, _listener._dispatchMessage.size());
+    TEST_ASSERT_EQUAL_UINT32(gestureID, _listener._dispatchMessage.at(1).midiIndex);
+
+    //holding the button after double tap shouldn't trigger long press
+    wait(1000);
+    TEST_ASSERT_EQUAL_UINT32(0, _listener._dispatchMessage.size());
+
+    setButton(false);
+    TEST_ASSERT_EQUAL_UINT32(2, _listener._dispatchMessage.size());
+
+    //second press after double tap time is a regular press
+    wait(300);
+    setButton(true);
+    TEST_ASSERT_EQUAL_UINT32(1, _listener._dispatchMessage.size());
+    setButton(false);
+
+    //hold-repeat without long press: regular note on every 100 ms
+    TEST_ASSERT(_database.update(Database::Section::button_t::gestureLongPressTime, index, 0) == true);
+    TEST_ASSERT(_database.update(Database::Section::button_t::gestureDoubleTapTime, index, 0) == true);
+    TEST_ASSERT(_database.update(Database::Section::button_t::gestureRepeatTime, index, 10) == true);
+    _buttons.reset(index);
+
+    setButton(true);
+
+    for (int i = 0; i < 5; i++)
+    {
+        wait(100);
+        TEST_ASSERT_EQUAL_UINT32(1, _listener._dispatchMessage.size());
+        TEST_ASSERT_EQUAL_UINT32(MIDI::messageType_t::noteOn, _listener._dispatchMessage.at(0).message);
+        TEST_ASSERT_EQUAL_UINT32(index, _listener._dispatchMessage.at(0).midiIndex);
+    }
+
+    //no repeats once released
+    setButton(false);
+    wait(1000);
+    TEST_ASSERT_EQUAL_UINT32(0, _listener._dispatchMessage.size());
+
+    //long press followed by repeating gesture
+    TEST_ASSERT(_database.update(Database::Section::button_t::gestureLongPressTime, index, 50) == true);
+    _buttons.reset(index);
+
+    setButton(true);
+    wait(500);
+    verifyGesture(MIDI::messageType_t::noteOn);
+
+    for (int i = 0; i < 5; i++)
+    {
+        wait(100);
+        verifyGesture(MIDI::messageType_t::noteOn);
+    }
+
+    //reset stops pending gestures
+    _hwaButtons._state[index] = false;
+    _buttons.reset(index);
+    wait(1000);
+    TEST_ASSERT_EQUAL_UINT32(0, _listener._dispatchMessage.size());
+}
+#endif
+
 TEST_CASE(PresetChange)
 {
     using namespace IO;
@@ -724,6 +939,10 @@ TEST_CASE(PresetChange)
         public:
         DBhandlers() = default;
 
+        void presetChangeStart(uint8_t preset) override
+        {
+        }
+
         void presetChange(uint8_t preset) override
         {
             _preset = preset;
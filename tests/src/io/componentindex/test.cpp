@@ -0,0 +1,142 @@
+#include "unity/Framework.h"
+#include "io/common/Common.h"
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+    /// Amount of different activation IDs (MIDI notes/CCs) plus program change key.
+    constexpr size_t KEYS = 129;
+
+    /// Pseudo-random key assignment in which several components share the same key.
+    size_t keyOf(size_t component)
+    {
+        return (component * 37 + 11) % KEYS;
+    }
+
+    template<size_t components, size_t linearLimit>
+    void fill(IO::Common::ComponentIndex<components, KEYS, linearLimit>& index)
+    {
+        index.clear();
+
+        for (size_t i = 0; i < components; i++)
+            index.assign(i, keyOf(i));
+    }
+
+    template<size_t components>
+    void benchmark(size_t iterations)
+    {
+        static IO::Common::ComponentIndex<components, KEYS, 0>          indexed;
+        static IO::Common::ComponentIndex<components, KEYS, components> linear;
+        static uint8_t                                                  keys[components];
+
+        fill(indexed);
+        fill(linear);
+
+        for (size_t i = 0; i < components; i++)
+            keys[i] = keyOf(i);
+
+        //same callback is used in both cases: component key is verified for every visited component
+        size_t matches = 0;
+
+        auto callback = [&](size_t key) {
+            return [&, key](size_t component) {
+                if (keys[component] == key)
+                    matches++;
+            };
+        };
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < iterations; i++)
+            linear.forEach(i % KEYS, callback(i % KEYS));
+
+        auto   linearTime    = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        size_t linearMatches = matches;
+
+        matches = 0;
+        start   = std::chrono::steady_clock::now();
+
+        for (size_t i = 0; i < iterations; i++)
+            indexed.forEach(i % KEYS, callback(i % KEYS));
+
+        auto indexedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        printf("%zu components: linear search: %.1f ns/lookup, indexed: %.1f ns/lookup (%zu matches)\n",
+               components,
+               static_cast<double>(linearTime) / iterations,
+               static_cast<double>(indexedTime) / iterations,
+               matches);
+
+        //both searches need to find the same components
+        TEST_ASSERT_EQUAL_UINT32(linearMatches, matches);
+    }
+}    // namespace
+
+TEST_CASE(MatchingComponents)
+{
+    static IO::Common::ComponentIndex<512, KEYS, 0> index;
+
+    fill(index);
+
+    for (size_t key = 0; key < KEYS; key++)
+    {
+        bool visited[512] = {};
+
+        index.forEach(key, [&](size_t component) {
+            //every component is visited once
+            TEST_ASSERT(visited[component] == false);
+            visited[component] = true;
+        });
+
+        for (size_t i = 0; i < 512; i++)
+            TEST_ASSERT(visited[i] == (keyOf(i) == key));
+    }
+
+    //invalid keys are ignored
+    size_t visits = 0;
+
+    index.forEach(KEYS, [&](size_t component) {
+        visits++;
+    });
+
+    TEST_ASSERT_EQUAL_UINT32(0, visits);
+
+    //nothing is visited after clearing
+    index.clear();
+
+    for (size_t key = 0; key < KEYS; key++)
+    {
+        index.forEach(key, [&](size_t component) {
+            visits++;
+        });
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, visits);
+}
+
+TEST_CASE(LinearBelowLimit)
+{
+    static IO::Common::ComponentIndex<32, KEYS> index;
+
+    TEST_ASSERT(index.INDEXED == false);
+
+    fill(index);
+
+    //all components are visited regardless of the key
+    size_t visits = 0;
+
+    index.forEach(keyOf(5), [&](size_t component) {
+        TEST_ASSERT_EQUAL_UINT32(visits, component);
+        visits++;
+    });
+
+    TEST_ASSERT_EQUAL_UINT32(32, visits);
+}
+
+TEST_CASE(Benchmark)
+{
+    benchmark<128>(100000);
+    benchmark<256>(100000);
+    benchmark<512>(100000);
+}
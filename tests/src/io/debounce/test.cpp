@@ -0,0 +1,206 @@
+#ifdef BUTTONS_SUPPORTED
+
+#include "unity/Framework.h"
+#include "io/buttons/Filter.h"
+#include <cstdio>
+
+namespace
+{
+    /// Bounce traces sampled once per millisecond, modelled after scope captures of real switches.
+    /// 1 is pressed reading, 0 released reading. | marks the ideal edge: the moment at which the
+    /// contact has been made or broken for the first time. Edges alternate between press and release.
+    struct trace_t
+    {
+        const char* name;
+        const char* samples;
+    };
+
+    const trace_t TRACES[] = {
+        {
+            "tactile",
+            "0000000000|10110111111111111111111111111111111111111|01010000000000000000",
+        },
+
+        {
+            "worn",
+            "0000000000|10010110101111111111111111011111111111111111111111111|101100101000000000000000000",
+        },
+
+        {
+            "drum roll",
+            "00000|1011111111|0100000000|1111111111|0000000000|1101111111|0010000000|1111111111|000000000000",
+        },
+
+        {
+            "noise",
+            "0000000100000000000001000000000000000100000000",
+        },
+    };
+
+    struct profile_t
+    {
+        const char*             name;
+        IO::Buttons::debounce_t debounce;
+        size_t                  expectedPresses[sizeof(TRACES) / sizeof(trace_t)];
+    };
+
+    const profile_t PROFILES[] = {
+        {
+            "instant press",
+            { IO::Buttons::debounceProfile_t::instantPress, 1, 5 },
+            //fires on every noise spike: trade-off for zero press latency
+            { 1, 1, 4, 3 },
+        },
+
+        {
+            "integrator",
+            { IO::Buttons::debounceProfile_t::integrator, 3, 5 },
+            { 1, 1, 4, 0 },
+        },
+
+        {
+            "N of M",
+            { IO::Buttons::debounceProfile_t::nOfM, 3, 5 },
+            { 1, 1, 4, 0 },
+        },
+    };
+
+    struct result_t
+    {
+        size_t edges             = 0;
+        size_t presses           = 0;
+        size_t releases          = 0;
+        size_t pressLatency      = 0;
+        size_t releaseLatency    = 0;
+        size_t maxPressLatency   = 0;
+        size_t maxReleaseLatency = 0;
+    };
+
+    /// Feeds the trace to filter sample by sample and measures the delay between
+    /// ideal and filtered edges.
+    result_t replay(const trace_t& trace, const IO::Buttons::debounce_t& debounce)
+    {
+        result_t result;
+        uint32_t readings = 0;
+        bool     state    = false;
+        size_t   sample   = 0;
+        size_t   edges[64];
+
+        for (const char* c = trace.samples; *c; c++)
+        {
+            if (*c == '|')
+            {
+                edges[result.edges++] = sample;
+                continue;
+            }
+
+            readings = (readings << 1) | (*c == '1');
+
+            bool newState = IO::ButtonsFilter::filter(debounce, state, false, readings);
+
+            if (newState != state)
+            {
+                if (newState)
+                    result.presses++;
+                else
+                    result.releases++;
+
+                const size_t edge = result.presses + result.releases - 1;
+
+                //latency is only meaningful for edges which exist in the trace
+                if (edge < result.edges)
+                {
+                    const size_t latency = sample - edges[edge];
+
+                    if (newState)
+                    {
+                        result.pressLatency += latency;
+
+                        if (latency > result.maxPressLatency)
+                            result.maxPressLatency = latency;
+                    }
+                    else
+                    {
+                        result.releaseLatency += latency;
+
+                        if (latency > result.maxReleaseLatency)
+                            result.maxReleaseLatency = latency;
+                    }
+                }
+
+                state = newState;
+            }
+
+            sample++;
+        }
+
+        return result;
+    }
+}    // namespace
+
+TEST_CASE(BounceTraces)
+{
+    printf("\n%-14s %-12s %8s %16s %18s\n", "profile", "trace", "presses", "press lat. [ms]", "release lat. [ms]");
+
+    for (size_t profile = 0; profile < sizeof(PROFILES) / sizeof(profile_t); profile++)
+    {
+        for (size_t trace = 0; trace < sizeof(TRACES) / sizeof(trace_t); trace++)
+        {
+            auto result = replay(TRACES[trace], PROFILES[profile].debounce);
+
+            if (result.edges && (result.edges == (result.presses + result.releases)))
+            {
+                printf("%-14s %-12s %8zu %9.1f (max %zu) %11.1f (max %zu)\n",
+                       PROFILES[profile].name,
+                       TRACES[trace].name,
+                       result.presses,
+                       static_cast<float>(result.pressLatency) / result.presses,
+                       result.maxPressLatency,
+                       static_cast<float>(result.releaseLatency) / result.releases,
+                       result.maxReleaseLatency);
+            }
+            else
+            {
+                printf("%-14s %-12s %8zu\n", PROFILES[profile].name, TRACES[trace].name, result.presses);
+            }
+
+            //every press needs to be followed by release and no bounce should be reported as extra press
+            TEST_ASSERT_EQUAL_UINT32(PROFILES[profile].expectedPresses[trace], result.presses);
+            TEST_ASSERT_EQUAL_UINT32(result.presses, result.releases);
+        }
+    }
+}
+
+TEST_CASE(PressLatency)
+{
+    //instant press profile reacts to first pressed reading
+    //other profiles need at least press samples to register the press
+    for (size_t profile = 0; profile < sizeof(PROFILES) / sizeof(profile_t); profile++)
+    {
+        auto result = replay(TRACES[0], PROFILES[profile].debounce);
+
+        if (PROFILES[profile].debounce.profile == IO::Buttons::debounceProfile_t::instantPress)
+            TEST_ASSERT_EQUAL_UINT32(0, result.maxPressLatency);
+        else
+            TEST_ASSERT(result.maxPressLatency >= static_cast<size_t>(PROFILES[profile].debounce.pressSamples - 1));
+    }
+}
+
+TEST_CASE(HistoryLimit)
+{
+    //parameters larger than history are constrained to its size
+    IO::Buttons::debounce_t debounce = { IO::Buttons::debounceProfile_t::integrator, 255, 255 };
+
+    TEST_ASSERT(IO::ButtonsFilter::filter(debounce, false, false, 0xFFFFFFFF) == true);
+    TEST_ASSERT(IO::ButtonsFilter::filter(debounce, false, false, 0x7FFFFFFF) == false);
+    TEST_ASSERT(IO::ButtonsFilter::filter(debounce, true, false, 0x80000000) == true);
+    TEST_ASSERT(IO::ButtonsFilter::filter(debounce, true, false, 0) == false);
+
+    //board profile only forwards the state debounced on board level
+    debounce.profile = IO::Buttons::debounceProfile_t::board;
+
+    TEST_ASSERT(IO::ButtonsFilter::filter(debounce, false, true, 0) == true);
+    TEST_ASSERT(IO::ButtonsFilter::filter(debounce, true, false, 0xFFFFFFFF) == false);
+}
+
+#endif
\ No newline at end of file
@@ -2,11 +2,15 @@
 
 #include "unity/Framework.h"
 #include "io/encoders/Encoders.h"
+#include "io/encoders/Filter.h"
+#include "board/common/io/QuadratureDecoder.h"
 #include "core/src/general/Timing.h"
 #include "database/Database.h"
 #include "stubs/database/DB_ReadWrite.h"
 #include "stubs/EncodersFilter.h"
 #include "stubs/Listener.h"
+#include <chrono>
+#include <cstdio>
 
 namespace
 {
@@ -16,16 +20,21 @@ namespace
         HWAEncoders()
         {}
 
-        bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) override
+        bool changed(IO::Encoders::changedBitmap_t& bitmap) override
         {
-            numberOfReadings = 1;
-            states           = _state;
+            //report all encoders as changed so that every state is processed
+            bitmap.fill(0xFFFFFFFF);
+            return true;
+        }
 
+        bool pulses(size_t index, int16_t& pulses) override
+        {
+            pulses = _pulses;
             return true;
         }
 
-        //use the same state for all encoders
-        uint32_t _state = 0;
+        //use the same pulses for all encoders
+        int16_t _pulses = 0;
     } _hwaEncoders;
 
     Util::MessageDispatcher _dispatcher;
@@ -33,7 +42,206 @@ namespace
     DBstorageMock           _dbStorageMock;
     Database                _database = Database(_dbStorageMock, true);
     EncodersFilterStub      _encodersFilter;
-    IO::Encoders            _encoders = IO::Encoders(_hwaEncoders, _encodersFilter, 1, _database, _dispatcher);
+    IO::Encoders            _encoders = IO::Encoders(_hwaEncoders, _encodersFilter, _database, _dispatcher);
+
+    /// Quadrature states of single detent in clockwise direction, A signal in bit 1 and B signal in bit 0.
+    constexpr uint8_t CW_SEQUENCE[4] = { 0b10, 0b11, 0b01, 0b00 };
+
+    /// Synthetic encoder movement used to measure decoding.
+    struct stream_t
+    {
+        std::vector<uint8_t> states;
+        size_t               cwSteps  = 0;
+        size_t               ccwSteps = 0;
+    };
+
+    /// Parameters from which the synthetic movement is generated.
+    struct scenario_t
+    {
+        const char* name;
+        uint8_t     samplesPerPulse;    ///< Amount of readings for which every state is held.
+        uint8_t     bounce;             ///< Contact bounces on one in n edges, 0 if contacts don't bounce.
+        uint16_t    reverseEvery;       ///< Direction is changed after n detents, 0 if it's never changed.
+    };
+
+    uint32_t nextRandom(uint32_t& seed)
+    {
+        seed = seed * 1103515245 + 12345;
+        return seed >> 16;
+    }
+
+    stream_t generateStream(const scenario_t& scenario, size_t detents, uint32_t seed)
+    {
+        stream_t stream;
+        uint8_t  phase = 0;
+
+        auto stateOf = [](uint8_t phase) {
+            return CW_SEQUENCE[(phase + 3) % 4];
+        };
+
+        //start in rest position so that decoder is primed before the first pulse
+        stream.states.push_back(0b00);
+
+        for (size_t detent = 0; detent < detents; detent++)
+        {
+            const bool cw = !scenario.reverseEvery || !((detent / scenario.reverseEvery) % 2);
+
+            for (int pulse = 0; pulse < 4; pulse++)
+            {
+                const uint8_t previous = stateOf(phase);
+
+                phase = cw ? (phase + 1) % 4 : (phase + 3) % 4;
+
+                const uint8_t current = stateOf(phase);
+
+                for (uint8_t sample = 0; sample < scenario.samplesPerPulse; sample++)
+                {
+                    //bounce shows up as short return to the previous state right after the edge
+                    const bool bounce = (sample == 1) && ((sample + 1) < scenario.samplesPerPulse) && scenario.bounce && !(nextRandom(seed) % scenario.bounce);
+                    stream.states.push_back(bounce ? previous : current);
+                }
+            }
+
+            if (cw)
+                stream.cwSteps++;
+            else
+                stream.ccwSteps++;
+        }
+
+        return stream;
+    }
+
+    /// Provides the synthetic stream to encoders in batches, the same way board provides
+    /// the pulses decoded between two updates. Readings are decoded as soon as they're
+    /// taken, the same way board does in interrupt.
+    class HWAStream : public IO::Encoders::HWA
+    {
+        public:
+        HWAStream(const std::vector<uint8_t>& states, uint8_t readingsPerUpdate)
+            : _states(states)
+            , _readingsPerUpdate(readingsPerUpdate > 16 ? 16 : readingsPerUpdate)
+        {}
+
+        bool changed(IO::Encoders::changedBitmap_t& bitmap) override
+        {
+            bitmap.fill(0xFFFFFFFF);
+            return true;
+        }
+
+        bool pulses(size_t index, int16_t& pulses) override
+        {
+            pulses         = _pulses[index];
+            _pulses[index] = 0;
+
+            return true;
+        }
+
+        /// Takes the next batch of readings from the stream.
+        /// returns: Amount of readings in batch, 0 once the entire stream has been used.
+        uint8_t next()
+        {
+            uint8_t batchSize = 0;
+
+            while ((batchSize < _readingsPerUpdate) && (_position < _states.size()))
+            {
+                const uint8_t state = _states[_position++];
+
+                batchSize++;
+
+                //signal A is in upper bit of the pair
+                for (size_t i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+                {
+                    _readingsA[i] = (_readingsA[i] << 1) | ((state >> 1) & 0x01);
+                    _readingsB[i] = (_readingsB[i] << 1) | (state & 0x01);
+                    _pulses[i] += Board::detail::io::quadraturePulse(_readingsA[i], _readingsB[i]);
+                }
+            }
+
+            return batchSize;
+        }
+
+        private:
+        const std::vector<uint8_t>& _states;
+        const uint8_t               _readingsPerUpdate;
+        size_t                      _position                          = 0;
+        uint32_t                    _readingsA[MAX_NUMBER_OF_ENCODERS] = {};
+        uint32_t                    _readingsB[MAX_NUMBER_OF_ENCODERS] = {};
+        int16_t                     _pulses[MAX_NUMBER_OF_ENCODERS]    = {};
+    };
+
+    /// Result of feeding single stream through all encoders.
+    struct streamResult_t
+    {
+        int64_t  time     = 0;
+        size_t   samples  = 0;
+        size_t   updates  = 0;
+        size_t   messages = 0;
+        size_t   cwSteps  = 0;    ///< Clockwise steps decoded by single encoder.
+        size_t   ccwSteps = 0;    ///< Counter-clockwise steps decoded by single encoder.
+        uint32_t maxValue = 0;    ///< Largest amount of steps in single message.
+    };
+
+    void configureRelative(uint8_t pulsesPerStep)
+    {
+        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        {
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::enable, i, 1) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::invert, i, 0) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::mode, i, IO::Encoders::type_t::controlChange7Fh01h) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::pulsesPerStep, i, pulsesPerStep) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::acceleration, i, 0) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::remoteSync, i, 0) == true);
+        }
+    }
+
+    /// Feeds the stream through all encoders with either filter used in firmware or no filtering.
+    /// Every encoder receives the same stream.
+    streamResult_t runStream(const std::vector<uint8_t>& states, uint8_t readingsPerUpdate, bool filter)
+    {
+        Util::MessageDispatcher dispatcher;
+        HWAStream               hwa(states, readingsPerUpdate);
+        IO::EncodersFilter      encodersFilter;
+        EncodersFilterStub      noFilter;
+        IO::Encoders            encoders(hwa,
+                              filter ? static_cast<IO::Encoders::Filter&>(encodersFilter) : static_cast<IO::Encoders::Filter&>(noFilter),
+                              _database,
+                              dispatcher);
+        streamResult_t          result;
+
+        dispatcher.listen(Util::MessageDispatcher::messageSource_t::encoders,
+                          Util::MessageDispatcher::listenType_t::nonFwd,
+                          [&](const Util::MessageDispatcher::message_t& dispatchMessage) {
+                              //7Fh/01h mode: clockwise steps are sent as is, counter-clockwise as 128 - steps
+                              const int32_t steps = dispatchMessage.midiValue < 64 ? dispatchMessage.midiValue : dispatchMessage.midiValue - 128;
+
+                              result.messages++;
+
+                              if (!dispatchMessage.componentIndex)
+                              {
+                                  if (steps > 0)
+                                      result.cwSteps += steps;
+                                  else
+                                      result.ccwSteps -= steps;
+                              }
+
+                              if (static_cast<uint32_t>(abs(steps)) > result.maxValue)
+                                  result.maxValue = abs(steps);
+                          });
+
+        auto start = std::chrono::steady_clock::now();
+
+        while (uint8_t readings = hwa.next())
+        {
+            core::timing::detail::rTime_ms += readings;
+            encoders.update();
+            result.samples += readings;
+            result.updates++;
+        }
+
+        result.time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        return result;
+    }
 }    // namespace
 
 TEST_SETUP()
@@ -77,9 +285,17 @@ TEST_CASE(StateDecoding)
         TEST_ASSERT(_database.update(Database::Section::encoder_t::pulsesPerStep, i, 1) == true);
     }
 
+    //pin readings are decoded the same way board does it on every sample
+    static uint32_t readingsA = 0;
+    static uint32_t readingsB = 0;
+
     auto setState = [](uint8_t state) {
-        _hwaEncoders._state = state;
+        readingsA = (readingsA << 1) | ((state >> 1) & 0x01);
+        readingsB = (readingsB << 1) | (state & 0x01);
+
+        _hwaEncoders._pulses = Board::detail::io::quadraturePulse(readingsA, readingsB);
         _encoders.update();
+        _hwaEncoders._pulses = 0;
     };
 
     auto verifyValue = [](MIDI::messageType_t message, uint16_t value) {
@@ -316,4 +532,588 @@ TEST_CASE(StateDecoding)
     verifyValue(MIDI::messageType_t::controlChange, 127);
 }
 
-#endif
\ No newline at end of file
+TEST_CASE(HardwarePulses)
+{
+    using namespace IO;
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::enable, i, 1) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::invert, i, 0) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::mode, i, Encoders::type_t::controlChange7Fh01h) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::pulsesPerStep, i, 4) == true);
+    }
+
+    auto setPulses = [](int16_t pulses) {
+        _hwaEncoders._pulses = pulses;
+        _encoders.update();
+    };
+
+    //nothing should be sent without pulses
+    setPulses(0);
+    TEST_ASSERT_EQUAL_UINT32(0, _listener._dispatchMessage.size());
+
+    //counter increasing is clockwise movement
+    setPulses(4);
+    TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS, _listener._dispatchMessage.size());
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        TEST_ASSERT_EQUAL_UINT32(1, _listener._dispatchMessage.at(i).midiValue);
+
+    _listener._dispatchMessage.clear();
+
+    //several steps can be counted between two reads, they are sent in single message
+    setPulses(9);
+    TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS, _listener._dispatchMessage.size());
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        TEST_ASSERT_EQUAL_UINT32(2, _listener._dispatchMessage.at(i).midiValue);
+
+    _listener._dispatchMessage.clear();
+
+    //leftover pulse is kept until the step is complete
+    setPulses(3);
+    TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS, _listener._dispatchMessage.size());
+    _listener._dispatchMessage.clear();
+
+    setPulses(-2);
+    TEST_ASSERT_EQUAL_UINT32(0, _listener._dispatchMessage.size());
+
+    setPulses(-2);
+    TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS, _listener._dispatchMessage.size());
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        TEST_ASSERT_EQUAL_UINT32(127, _listener._dispatchMessage.at(i).midiValue);
+
+    _hwaEncoders._pulses = 0;
+}
+
+TEST_CASE(RemoteSync)
+{
+    using namespace IO;
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::enable, i, 1) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::invert, i, 0) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::mode, i, Encoders::type_t::controlChange) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::pulsesPerStep, i, 1) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::acceleration, i, 0) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::midiChannel, i, 1) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::midiID, i, i % 128) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::remoteSync, i, 0) == true);
+    }
+
+    //only the last encoder should react to incoming message
+    const int syncedEncoder = MAX_NUMBER_OF_ENCODERS - 1;
+    TEST_ASSERT(_database.update(Database::Section::encoder_t::remoteSync, syncedEncoder, 1) == true);
+
+    auto move = []() {
+        _hwaEncoders._pulses = 1;
+        _encoders.update();
+        _hwaEncoders._pulses = 0;
+    };
+
+    //bring all encoders to known value
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        _encoders.resetValue(i);
+
+    _dispatcher.notify(Util::MessageDispatcher::messageSource_t::midiIn, { 0, 1, static_cast<uint16_t>(syncedEncoder % 128), 50, MIDI::messageType_t::controlChange }, Util::MessageDispatcher::listenType_t::nonFwd);
+
+    //message on different channel shouldn't change anything
+    _dispatcher.notify(Util::MessageDispatcher::messageSource_t::midiIn, { 0, 2, static_cast<uint16_t>(syncedEncoder % 128), 100, MIDI::messageType_t::controlChange }, Util::MessageDispatcher::listenType_t::nonFwd);
+
+    move();
+    TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS, _listener._dispatchMessage.size());
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        TEST_ASSERT_EQUAL_UINT32(i == syncedEncoder ? 51 : 1, _listener._dispatchMessage.at(i).midiValue);
+
+    _listener._dispatchMessage.clear();
+
+    //lookup should follow the configuration change
+    TEST_ASSERT(_database.update(Database::Section::encoder_t::remoteSync, syncedEncoder, 0) == true);
+    _dispatcher.notify(Util::MessageDispatcher::messageSource_t::midiIn, { 0, 1, static_cast<uint16_t>(syncedEncoder % 128), 100, MIDI::messageType_t::controlChange }, Util::MessageDispatcher::listenType_t::nonFwd);
+
+    move();
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        TEST_ASSERT_EQUAL_UINT32(i == syncedEncoder ? 52 : 2, _listener._dispatchMessage.at(i).midiValue);
+}
+
+TEST_CASE(Acceleration)
+{
+    using namespace IO;
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::enable, i, 1) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::invert, i, 0) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::mode, i, Encoders::type_t::pitchBend) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::pulsesPerStep, i, 1) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::acceleration, i, Encoders::acceleration_t::fast) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::remoteSync, i, 0) == true);
+        _encoders.resetValue(i);
+    }
+
+    auto step = [](uint32_t interval, int16_t pulses = 1) {
+        core::timing::detail::rTime_ms += interval;
+        _listener._dispatchMessage.clear();
+
+        _hwaEncoders._pulses = pulses;
+        _encoders.update();
+        _hwaEncoders._pulses = 0;
+
+        TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS, _listener._dispatchMessage.size());
+        return _listener._dispatchMessage.at(0).midiValue;
+    };
+
+    //slow movement keeps single step precision
+    uint16_t value = 8192;
+
+    for (int i = 0; i < 10; i++)
+        TEST_ASSERT_EQUAL_UINT32(++value, step(200));
+
+    //fast flick should cover the entire 14-bit range
+    for (int i = 0; i < 20; i++)
+        value = step(5);
+
+    TEST_ASSERT_EQUAL_UINT32(16383, value);
+
+    //steps read in single update should be spread over the time elapsed since the previous update
+    //so that slow update doesn't turn slow movement into fast one
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        _encoders.resetValue(i);
+
+    value = 8192;
+
+    for (int i = 0; i < 5; i++)
+    {
+        value += 4;
+        TEST_ASSERT_EQUAL_UINT32(value, step(800, 4));
+    }
+
+    //value change should follow the curve stored in database
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        _encoders.resetValue(i);
+
+    for (size_t i = 0; i < Encoders::ACCELERATION_CURVE_POINTS; i++)
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::accelerationCurve, ((static_cast<size_t>(Encoders::acceleration_t::fast) - 1) * Encoders::ACCELERATION_CURVE_POINTS) + i, 1) == true);
+
+    value = 8192;
+
+    for (int i = 0; i < 20; i++)
+        TEST_ASSERT_EQUAL_UINT32(++value, step(5));
+}
+
+#endif
+
+TEST_CASE(RelativeModes)
+{
+    using namespace IO;
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::enable, i, 1) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::invert, i, 0) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::mode, i, Encoders::type_t::controlChange41h01h) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::pulsesPerStep, i, 4) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::acceleration, i, 0) == true);
+    }
+
+    auto setPulses = [](int16_t pulses) {
+        _listener._dispatchMessage.clear();
+        _hwaEncoders._pulses = pulses;
+        _encoders.update();
+    };
+
+    auto verifyValues = [](uint16_t value) {
+        TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS, _listener._dispatchMessage.size());
+
+        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+            TEST_ASSERT_EQUAL_UINT32(value, _listener._dispatchMessage.at(i).midiValue);
+    };
+
+    //sign and magnitude: clockwise steps are sent as is, counter-clockwise steps have bit 6 set
+    setPulses(12);
+    verifyValues(3);
+
+    setPulses(-8);
+    verifyValues(0x42);
+
+    //magnitude is limited to 63 steps
+    setPulses(-400);
+    verifyValues(0x7F);
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::mode, i, Encoders::type_t::nrpn14bitRelative) == true);
+
+    //every pulse is sent in high resolution mode regardless of pulses per step setting
+    setPulses(1);
+    verifyValues(1);
+
+    setPulses(7);
+    verifyValues(7);
+
+    //counter-clockwise movement is sent as 14-bit two's complement
+    setPulses(-1);
+    verifyValues(0x3FFF);
+
+    setPulses(-300);
+    verifyValues(16384 - 300);
+
+    _hwaEncoders._pulses = 0;
+}
+
+TEST_CASE(EnableBitmap)
+{
+    using namespace IO;
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        //enable only every other encoder
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::enable, i, !(i % 2)) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::invert, i, 0) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::mode, i, Encoders::type_t::controlChange7Fh01h) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::pulsesPerStep, i, 1) == true);
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::acceleration, i, 0) == true);
+    }
+
+    auto move = []() {
+        _listener._dispatchMessage.clear();
+        _hwaEncoders._pulses = 1;
+        _encoders.update();
+        _hwaEncoders._pulses = 0;
+    };
+
+    move();
+    TEST_ASSERT_EQUAL_UINT32((MAX_NUMBER_OF_ENCODERS + 1) / 2, _listener._dispatchMessage.size());
+
+    for (size_t i = 0; i < _listener._dispatchMessage.size(); i++)
+        TEST_ASSERT_EQUAL_UINT32(i * 2, _listener._dispatchMessage.at(i).componentIndex);
+
+    //change in database should be applied on the next update
+    TEST_ASSERT(_database.update(Database::Section::encoder_t::enable, 1, 1) == true);
+    TEST_ASSERT(_database.update(Database::Section::encoder_t::enable, 0, 0) == true);
+
+    move();
+    TEST_ASSERT_EQUAL_UINT32((MAX_NUMBER_OF_ENCODERS + 1) / 2, _listener._dispatchMessage.size());
+    TEST_ASSERT_EQUAL_UINT32(1, _listener._dispatchMessage.at(0).componentIndex);
+
+    if (_database.getSupportedPresets() > 1)
+    {
+        //enable state from newly selected preset should be used after preset change
+        TEST_ASSERT(_database.setPreset(1) == true);
+
+        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        {
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::enable, i, 0) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::pulsesPerStep, i, 1) == true);
+        }
+
+        move();
+        TEST_ASSERT_EQUAL_UINT32(0, _listener._dispatchMessage.size());
+
+        TEST_ASSERT(_database.setPreset(0) == true);
+
+        move();
+        TEST_ASSERT_EQUAL_UINT32((MAX_NUMBER_OF_ENCODERS + 1) / 2, _listener._dispatchMessage.size());
+        TEST_ASSERT_EQUAL_UINT32(1, _listener._dispatchMessage.at(0).componentIndex);
+    }
+}
+
+TEST_CASE(PresetValues)
+{
+    using namespace IO;
+
+    if (_database.getSupportedPresets() < 2)
+        return;
+
+    auto configure = []() {
+        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        {
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::enable, i, 1) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::invert, i, 0) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::mode, i, Encoders::type_t::controlChange) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::pulsesPerStep, i, 1) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::acceleration, i, 0) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::remoteSync, i, 0) == true);
+            _encoders.resetValue(i);
+        }
+    };
+
+    auto move = [](Encoders& encoders, int16_t pulses) {
+        _listener._dispatchMessage.clear();
+        _hwaEncoders._pulses = pulses;
+        encoders.update();
+        _hwaEncoders._pulses = 0;
+    };
+
+    auto verifyValues = [](uint16_t value) {
+        TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS, _listener._dispatchMessage.size());
+
+        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+            TEST_ASSERT_EQUAL_UINT32(value, _listener._dispatchMessage.at(i).midiValue);
+    };
+
+    //start without stored values in both presets
+    for (int preset = 0; preset < 2; preset++)
+    {
+        TEST_ASSERT(_database.setPreset(preset) == true);
+
+        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::valueStored, i, 0) == true);
+    }
+
+    TEST_ASSERT(_database.setPreset(0) == true);
+    configure();
+
+    move(_encoders, 3);
+    verifyValues(3);
+
+    //values in other preset start from default
+    TEST_ASSERT(_database.setPreset(1) == true);
+    configure();
+
+    move(_encoders, 1);
+    verifyValues(1);
+
+    //values from the first preset should be restored once it's selected again
+    TEST_ASSERT(_database.setPreset(0) == true);
+
+    move(_encoders, 1);
+    verifyValues(4);
+
+    //values shouldn't be written to database while encoders are still moving
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        TEST_ASSERT_EQUAL_UINT32(0, _database.read(Database::Section::encoder_t::valueStored, i));
+
+    //writing the values shouldn't invalidate cached configuration
+    const uint32_t revision = _database.revision();
+
+    core::timing::detail::rTime_ms += Encoders::VALUE_STORE_DELAY;
+    move(_encoders, 0);
+
+    TEST_ASSERT_EQUAL_UINT32(revision, _database.revision());
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(4, _database.read(Database::Section::encoder_t::value, i));
+        TEST_ASSERT_EQUAL_UINT32(1, _database.read(Database::Section::encoder_t::valueStored, i));
+    }
+
+    //stored values should be used after restart
+    Util::MessageDispatcher dispatcher;
+    Encoders                restarted(_hwaEncoders, _encodersFilter, _database, dispatcher);
+
+    dispatcher.listen(Util::MessageDispatcher::messageSource_t::encoders,
+                      Util::MessageDispatcher::listenType_t::nonFwd,
+                      [](const Util::MessageDispatcher::message_t& dispatchMessage) {
+                          _listener.messageListener(dispatchMessage);
+                      });
+
+    move(restarted, 1);
+    verifyValues(5);
+
+    //values changed in the second preset are written once it's selected again
+    TEST_ASSERT(_database.setPreset(1) == true);
+
+    core::timing::detail::rTime_ms += Encoders::VALUE_STORE_DELAY;
+    move(_encoders, 0);
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        TEST_ASSERT_EQUAL_UINT32(1, _database.read(Database::Section::encoder_t::value, i));
+
+    //values written to database by anything else (ie. preset load) should replace the ones in RAM
+    TEST_ASSERT(_database.setPreset(0) == true);
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        TEST_ASSERT(_database.update(Database::Section::encoder_t::value, i, 10) == true);
+
+    move(_encoders, 1);
+    verifyValues(11);
+}
+
+TEST_CASE(PresetChangeStoresValues)
+{
+    using namespace IO;
+
+    if (_database.getSupportedPresets() < 2)
+        return;
+
+    //store pending values on preset change the same way the system does
+    static class DBhandlers : public Database::Handlers
+    {
+        public:
+        DBhandlers() = default;
+
+        void presetChangeStart(uint8_t preset) override
+        {
+            _encoders.storeValues();
+        }
+
+        void presetChange(uint8_t preset) override
+        {
+        }
+
+        void factoryResetStart() override
+        {
+        }
+
+        void factoryResetDone() override
+        {
+        }
+
+        void initialized() override
+        {
+        }
+    } _dbHandlers;
+
+    _database.registerHandlers(_dbHandlers);
+
+    auto move = [](Encoders& encoders, int16_t pulses) {
+        _listener._dispatchMessage.clear();
+        _hwaEncoders._pulses = pulses;
+        encoders.update();
+        _hwaEncoders._pulses = 0;
+    };
+
+    for (int preset = 1; preset >= 0; preset--)
+    {
+        TEST_ASSERT(_database.setPreset(preset) == true);
+
+        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        {
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::enable, i, 1) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::invert, i, 0) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::mode, i, Encoders::type_t::controlChange) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::pulsesPerStep, i, 1) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::acceleration, i, 0) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::remoteSync, i, 0) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::value, i, 0) == true);
+            TEST_ASSERT(_database.update(Database::Section::encoder_t::valueStored, i, 0) == true);
+        }
+
+        for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+            _encoders.resetValue(i);
+    }
+
+    move(_encoders, 2);
+    TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS, _listener._dispatchMessage.size());
+
+    //preset is changed before the values would be written on their own
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        TEST_ASSERT_EQUAL_UINT32(0, _database.read(Database::Section::encoder_t::valueStored, i));
+
+    TEST_ASSERT(_database.setPreset(1) == true);
+    move(_encoders, 0);
+
+    //values of the left preset mustn't end up in the newly selected one
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        TEST_ASSERT_EQUAL_UINT32(0, _database.read(Database::Section::encoder_t::value, i));
+
+    //values should be loaded from database after restart
+    Util::MessageDispatcher dispatcher;
+    Encoders                restarted(_hwaEncoders, _encodersFilter, _database, dispatcher);
+
+    dispatcher.listen(Util::MessageDispatcher::messageSource_t::encoders,
+                      Util::MessageDispatcher::listenType_t::nonFwd,
+                      [](const Util::MessageDispatcher::message_t& dispatchMessage) {
+                          _listener.messageListener(dispatchMessage);
+                      });
+
+    TEST_ASSERT(_database.setPreset(0) == true);
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(2, _database.read(Database::Section::encoder_t::value, i));
+        TEST_ASSERT_EQUAL_UINT32(1, _database.read(Database::Section::encoder_t::valueStored, i));
+    }
+
+    move(restarted, 1);
+    TEST_ASSERT_EQUAL_UINT32(MAX_NUMBER_OF_ENCODERS, _listener._dispatchMessage.size());
+
+    for (int i = 0; i < MAX_NUMBER_OF_ENCODERS; i++)
+        TEST_ASSERT_EQUAL_UINT32(3, _listener._dispatchMessage.at(i).midiValue);
+}
+
+TEST_CASE(Benchmark)
+{
+    using namespace IO;
+
+    const scenario_t scenarios[] = {
+        { "clean", 4, 0, 0 },
+        { "bouncy", 4, 3, 0 },
+        { "very fast", 1, 0, 0 },
+        { "reversals", 2, 0, 8 },
+    };
+
+    const uint8_t readingsPerUpdate[] = { 1, 4, 16 };
+
+    configureRelative(4);
+
+    for (const auto& scenario : scenarios)
+    {
+        const stream_t stream = generateStream(scenario, 5000, 1);
+
+        for (const auto readings : readingsPerUpdate)
+        {
+            for (const bool filter : { false, true })
+            {
+                const streamResult_t result = runStream(stream.states, readings, filter);
+                const size_t         lost   = abs(static_cast<int32_t>(stream.cwSteps - result.cwSteps)) + abs(static_cast<int32_t>(stream.ccwSteps - result.ccwSteps));
+
+                printf("%-9s %2u readings/update, %-9s: %.1f ns/sample, %.2f%% steps lost, %zu messages\n",
+                       scenario.name,
+                       readings,
+                       filter ? "filter" : "no filter",
+                       static_cast<double>(result.time) / (result.samples * MAX_NUMBER_OF_ENCODERS),
+                       100.0 * lost / (stream.cwSteps + stream.ccwSteps),
+                       result.messages);
+
+                //steps in single direction on signal without bounce must all be decoded
+                if (!scenario.bounce && !scenario.reverseEvery)
+                {
+                    TEST_ASSERT_EQUAL_UINT32(stream.cwSteps, result.cwSteps);
+                    TEST_ASSERT_EQUAL_UINT32(stream.ccwSteps, result.ccwSteps);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(Fuzz)
+{
+    using namespace IO;
+
+    uint32_t seed = 0x5EED;
+
+    for (int iteration = 0; iteration < 200; iteration++)
+    {
+        const uint8_t pulsesPerStep = 1 + (nextRandom(seed) % 4);
+        const uint8_t readings      = 1 + (nextRandom(seed) % 16);
+        const bool    filter        = nextRandom(seed) & 0x01;
+        size_t        transitions   = 0;
+
+        std::vector<uint8_t> states(1 + (nextRandom(seed) % 512));
+
+        for (size_t i = 0; i < states.size(); i++)
+        {
+            states[i] = nextRandom(seed) & 0x03;
+
+            if (i && (states[i] != states[i - 1]))
+                transitions++;
+        }
+
+        configureRelative(pulsesPerStep);
+
+        const streamResult_t result = runStream(states, readings, filter);
+
+        //every step needs at least pulsesPerStep transitions on encoder pins
+        TEST_ASSERT((result.cwSteps + result.ccwSteps) * pulsesPerStep <= transitions);
+
+        //single message per encoder is sent on each update
+        TEST_ASSERT(result.messages <= result.updates * MAX_NUMBER_OF_ENCODERS);
+        TEST_ASSERT(result.maxValue <= 63);
+    }
+}
@@ -0,0 +1,280 @@
+#include "unity/Framework.h"
+#include "io/analog/FilterKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace
+{
+    uint32_t nextRandom(uint32_t& seed)
+    {
+        seed = seed * 1103515245 + 12345;
+        return seed >> 16;
+    }
+
+    /// Noisy ADC reading of potentiometer which is slowly being moved.
+    uint16_t noisySample(size_t sample, uint32_t& seed)
+    {
+        const int32_t position = 2000 + static_cast<int32_t>((sample / 8) % 1000);
+        int32_t       noise    = static_cast<int32_t>(nextRandom(seed) % 9) - 4;
+
+        //occasional spike
+        if (!(nextRandom(seed) % 64))
+            noise = 500;
+
+        return position + noise;
+    }
+
+    uint64_t cycles()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    /// Filter used before the kernels were introduced: median of every size samples using qsort.
+    template<size_t size>
+    class QsortMedian
+    {
+        public:
+        bool process(uint16_t value, uint32_t time, uint16_t& filteredValue)
+        {
+            auto compare = [](const void* a, const void* b) {
+                if (*(uint16_t*)a < *(uint16_t*)b)
+                    return -1;
+                else if (*(uint16_t*)a > *(uint16_t*)b)
+                    return 1;
+
+                return 0;
+            };
+
+            _sample[_count++] = value;
+
+            if (_count < size)
+                return false;
+
+            qsort(_sample, size, sizeof(uint16_t), compare);
+            _count        = 0;
+            filteredValue = _sample[size / 2];
+
+            return true;
+        }
+
+        private:
+        uint16_t _sample[size] = {};
+        size_t   _count        = 0;
+    };
+
+    template<typename T>
+    void benchmark(const char* name, size_t iterations)
+    {
+        static constexpr size_t CHANNELS = 64;
+        static T                kernel[CHANNELS];
+        static uint16_t         samples[1024];
+
+        uint32_t seed = 1;
+
+        for (size_t i = 0; i < 1024; i++)
+            samples[i] = noisySample(i, seed);
+
+        size_t   outputs     = 0;
+        uint16_t filtered    = 0;
+        auto     start       = std::chrono::steady_clock::now();
+        uint64_t startCycles = cycles();
+
+        for (size_t i = 0; i < iterations; i++)
+        {
+            for (size_t channel = 0; channel < CHANNELS; channel++)
+            {
+                if (kernel[channel].process(samples[(i + channel) % 1024], i, filtered))
+                    outputs++;
+            }
+        }
+
+        uint64_t totalCycles = cycles() - startCycles;
+        auto     time        = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        printf("%-24s %.1f ns/sample, %.1f cycles/sample (%zu outputs)\n",
+               name,
+               static_cast<double>(time) / (iterations * CHANNELS),
+               static_cast<double>(totalCycles) / (iterations * CHANNELS),
+               outputs);
+    }
+
+    template<size_t size>
+    void verifyMedian()
+    {
+        uint16_t sample[size];
+        uint16_t sorted[size];
+        uint32_t seed = size;
+
+        //small range of values so that duplicates are common
+        for (size_t i = 0; i < 20000; i++)
+        {
+            for (size_t s = 0; s < size; s++)
+                sample[s] = sorted[s] = nextRandom(seed) % 8;
+
+            std::sort(sorted, sorted + size);
+            TEST_ASSERT_EQUAL_UINT32(sorted[size / 2], IO::FilterKernel::median(sample));
+        }
+
+        //every permutation of distinct values
+        for (size_t s = 0; s < size; s++)
+            sorted[s] = s;
+
+        do
+        {
+            std::copy(sorted, sorted + size, sample);
+            TEST_ASSERT_EQUAL_UINT32(size / 2, IO::FilterKernel::median(sample));
+        } while (std::next_permutation(sorted, sorted + size));
+    }
+
+    template<size_t size>
+    void verifyRunningMedian()
+    {
+        IO::FilterKernel::RunningMedian<size> kernel;
+        uint16_t                              window[size];
+        uint32_t                              seed     = size;
+        uint16_t                              filtered = 0;
+
+        for (size_t i = 0; i < 20000; i++)
+        {
+            const uint16_t value = noisySample(i, seed);
+
+            window[i % size] = value;
+
+            //no output until the window is filled
+            if (i < (size - 1))
+            {
+                TEST_ASSERT(kernel.process(value, i, filtered) == false);
+                continue;
+            }
+
+            TEST_ASSERT(kernel.process(value, i, filtered) == true);
+
+            uint16_t sorted[size];
+            std::copy(window, window + size, sorted);
+            std::sort(sorted, sorted + size);
+
+            TEST_ASSERT_EQUAL_UINT32(sorted[size / 2], filtered);
+        }
+    }
+}    // namespace
+
+TEST_CASE(MedianNetwork)
+{
+    verifyMedian<3>();
+    verifyMedian<5>();
+    verifyMedian<7>();
+}
+
+TEST_CASE(MedianKernel)
+{
+    IO::FilterKernel::Median<5> kernel;
+    uint16_t                    filtered = 0;
+
+    const uint16_t samples[] = { 100, 900, 102, 101, 0 };
+
+    for (size_t i = 0; i < 4; i++)
+        TEST_ASSERT(kernel.process(samples[i], i, filtered) == false);
+
+    //outliers are removed
+    TEST_ASSERT(kernel.process(samples[4], 4, filtered) == true);
+    TEST_ASSERT_EQUAL_UINT32(101, filtered);
+
+    //window is started again when sample isn't filtered
+    TEST_ASSERT(kernel.process(100, 5, filtered) == false);
+    kernel.track(100, 6);
+
+    for (size_t i = 0; i < 4; i++)
+        TEST_ASSERT(kernel.process(200, 7 + i, filtered) == false);
+
+    TEST_ASSERT(kernel.process(200, 11, filtered) == true);
+    TEST_ASSERT_EQUAL_UINT32(200, filtered);
+}
+
+TEST_CASE(RunningMedianKernel)
+{
+    verifyRunningMedian<3>();
+    verifyRunningMedian<5>();
+    verifyRunningMedian<7>();
+    verifyRunningMedian<9>();
+}
+
+TEST_CASE(ExponentialAverageKernel)
+{
+    IO::FilterKernel::ExponentialAverage<2> kernel;
+    uint16_t                                filtered = 0;
+
+    //first sample is used as is
+    TEST_ASSERT(kernel.process(1000, 0, filtered) == true);
+    TEST_ASSERT_EQUAL_UINT32(1000, filtered);
+
+    //every sample moves the average by a quarter of the difference
+    TEST_ASSERT(kernel.process(2000, 1, filtered) == true);
+    TEST_ASSERT_EQUAL_UINT32(1250, filtered);
+
+    //constant input is eventually reached
+    for (size_t i = 0; i < 100; i++)
+        kernel.process(2000, 2 + i, filtered);
+
+    TEST_ASSERT_EQUAL_UINT32(2000, filtered);
+
+    //average follows the samples whose filtered value isn't used
+    for (size_t i = 0; i < 100; i++)
+        kernel.track(500, 200 + i);
+
+    kernel.process(500, 300, filtered);
+    TEST_ASSERT_EQUAL_UINT32(500, filtered);
+}
+
+TEST_CASE(OneEuroKernel)
+{
+    IO::FilterKernel::OneEuro kernel;
+    uint16_t                  filtered = 0;
+    uint32_t                  seed     = 1;
+
+    TEST_ASSERT(kernel.process(2000, 0, filtered) == true);
+    TEST_ASSERT_EQUAL_UINT32(2000, filtered);
+
+    //jitter of stationary input is smoothed out
+    for (uint32_t time = 1; time < 1000; time++)
+    {
+        kernel.process(2000 + (nextRandom(seed) % 9) - 4, time, filtered);
+
+        if (time > 100)
+            TEST_ASSERT(abs(static_cast<int32_t>(filtered) - 2000) <= 1);
+    }
+
+    //fast movement is followed quickly
+    uint32_t time = 1000;
+
+    for (; time < 1050; time++)
+        kernel.process(3000, time, filtered);
+
+    TEST_ASSERT(abs(static_cast<int32_t>(filtered) - 3000) < 20);
+}
+
+TEST_CASE(Benchmark)
+{
+    using namespace IO::FilterKernel;
+
+    benchmark<QsortMedian<3>>("qsort median of 3", 100000);
+    benchmark<QsortMedian<5>>("qsort median of 5", 100000);
+    benchmark<QsortMedian<7>>("qsort median of 7", 100000);
+    benchmark<Median<3>>("median of 3", 100000);
+    benchmark<Median<5>>("median of 5", 100000);
+    benchmark<Median<7>>("median of 7", 100000);
+    benchmark<RunningMedian<3>>("running median of 3", 100000);
+    benchmark<RunningMedian<5>>("running median of 5", 100000);
+    benchmark<RunningMedian<7>>("running median of 7", 100000);
+    benchmark<ExponentialAverage<2>>("exponential average", 100000);
+    benchmark<OneEuro>("1 euro", 100000);
+}
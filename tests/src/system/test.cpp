@@ -87,7 +87,17 @@ namespace
 #endif
         }
 
-        bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) override
+        bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states, bool& debounced) override
+        {
+            return false;
+        }
+
+        bool changed(IO::Buttons::changedBitmap_t& bitmap) override
+        {
+            return false;
+        }
+
+        bool edgeTime(size_t index, uint32_t& time) override
         {
             return false;
         }
@@ -113,7 +123,12 @@ namespace
 #endif
         }
 
-        bool state(size_t index, uint8_t& numberOfReadings, uint32_t& states) override
+        bool changed(IO::Encoders::changedBitmap_t& bitmap) override
+        {
+            return false;
+        }
+
+        bool pulses(size_t index, int16_t& pulses) override
         {
             return false;
         }
@@ -381,6 +396,11 @@ namespace
             return false;
         }
 
+        bool inputScanTime(System::inputScanTime_t& scanTime) override
+        {
+            return false;
+        }
+
         System::HWA::IO& io() override
         {
             return _hwaIO;
@@ -603,4 +623,270 @@ TEST_CASE(ForcedResendOnPresetChange)
     //since the preset has been changed 3 times by now, all buttons should resend their state and all enabled analog components (only 1 in this case)
     TEST_ASSERT_EQUAL_UINT32((MAX_NUMBER_OF_BUTTONS + 1) * 3, channelMessages);
 }
+
+TEST_CASE(SysExSectionMapping)
+{
+    System systemStub(_hwaSystem, _database);
+
+    auto sendSysExRequest = [&](const std::vector<uint8_t> request) {
+        _hwaMIDI.usbReadPackets = MIDIHelper::rawSysExToUSBPackets(request);
+        auto packetSize         = _hwaMIDI.usbReadPackets.size();
+
+        for (size_t i = 0; i < packetSize; i++)
+            systemStub.run();
+    };
+
+    _database.factoryReset();
+    TEST_ASSERT(systemStub.init() == true);
+
+    //handshake
+    sendSysExRequest({ 0xF0,
+                       0x00,
+                       0x53,
+                       0x43,
+                       0x00,
+                       0x00,
+                       0x01,
+                       0xF7 });
+
+    std::vector<uint8_t> generatedSysExReq;
+
+#ifdef BUTTONS_SUPPORTED
+    //channels start from 1 in sysex and from 0 in database
+    MIDIHelper::generateSysExSetReq(System::Section::button_t::midiChannel, 0, 5, generatedSysExReq);
+    sendSysExRequest(generatedSysExReq);
+    TEST_ASSERT_EQUAL_UINT32(4, _database.read(Database::Section::button_t::midiChannel, 0));
+#endif
+
+#ifdef ANALOG_SUPPORTED
+    //msb sections aren't accessible over sysex and must not modify the database
+    MIDIHelper::generateSysExSetReq(System::Section::analog_t::midiID, 0, 10, generatedSysExReq);
+    sendSysExRequest(generatedSysExReq);
+    TEST_ASSERT_EQUAL_UINT32(10, _database.read(Database::Section::analog_t::midiID, 0));
+
+    MIDIHelper::generateSysExSetReq(System::Section::analog_t::midiID_MSB, 0, 1, generatedSysExReq);
+    sendSysExRequest(generatedSysExReq);
+    TEST_ASSERT_EQUAL_UINT32(10, _database.read(Database::Section::analog_t::midiID, 0));
+#endif
+}
+
+TEST_CASE(BulkRequests)
+{
+#ifdef BUTTONS_SUPPORTED
+    if (MAX_NUMBER_OF_BUTTONS < 3)
+        return;
+
+    System systemStub(_hwaSystem, _database);
+
+    auto sendSysExRequest = [&](const std::vector<uint8_t> request) {
+        _hwaMIDI.usbReadPackets = MIDIHelper::rawSysExToUSBPackets(request);
+        auto packetSize         = _hwaMIDI.usbReadPackets.size();
+
+        for (size_t i = 0; i < packetSize; i++)
+            systemStub.run();
+    };
+
+    _database.factoryReset();
+    TEST_ASSERT(systemStub.init() == true);
+
+    //handshake
+    sendSysExRequest({ 0xF0,
+                       0x00,
+                       0x53,
+                       0x43,
+                       0x00,
+                       0x00,
+                       0x01,
+                       0xF7 });
+
+    _hwaMIDI.reset();
+
+    //set midi id for first three buttons in single message
+    sendSysExRequest({ 0xF0,
+                       0x00,
+                       0x53,
+                       0x43,
+                       0x00,
+                       0x00,
+                       SYSEX_CR_BULK_SET,
+                       static_cast<uint8_t>(System::block_t::buttons),
+                       static_cast<uint8_t>(System::Section::button_t::midiID),
+                       0x00,    //start index MSB
+                       0x00,    //start index LSB
+                       0x03,    //count
+                       0x00,
+                       0x0A,
+                       0x00,
+                       0x0B,
+                       0x00,
+                       0x0C,
+                       0xF7 });
+
+    TEST_ASSERT_EQUAL_UINT32(10, _database.read(Database::Section::button_t::midiID, 0));
+    TEST_ASSERT_EQUAL_UINT32(11, _database.read(Database::Section::button_t::midiID, 1));
+    TEST_ASSERT_EQUAL_UINT32(12, _database.read(Database::Section::button_t::midiID, 2));
+
+    //single acknowledgement is expected
+    auto rawBytes = MIDIHelper::usbSysExToRawBytes(_hwaMIDI.usbWritePackets);
+
+    std::vector<uint8_t> expectedSetResponse = {
+        0xF0,
+        0x00,
+        0x53,
+        0x43,
+        static_cast<uint8_t>(SysExConf::status_t::ack),
+        0x00,
+        SYSEX_CR_BULK_SET,
+        static_cast<uint8_t>(System::block_t::buttons),
+        static_cast<uint8_t>(System::Section::button_t::midiID),
+        0x00,
+        0x00,
+        0x03,
+        0xF7
+    };
+
+    TEST_ASSERT(rawBytes == expectedSetResponse);
+
+    _hwaMIDI.reset();
+
+    //read the values back
+    sendSysExRequest({ 0xF0,
+                       0x00,
+                       0x53,
+                       0x43,
+                       0x00,
+                       0x00,
+                       SYSEX_CR_BULK_GET,
+                       static_cast<uint8_t>(System::block_t::buttons),
+                       static_cast<uint8_t>(System::Section::button_t::midiID),
+                       0x00,
+                       0x00,
+                       0x03,
+                       0xF7 });
+
+    rawBytes = MIDIHelper::usbSysExToRawBytes(_hwaMIDI.usbWritePackets);
+
+    std::vector<uint8_t> expectedGetResponse = {
+        0xF0,
+        0x00,
+        0x53,
+        0x43,
+        static_cast<uint8_t>(SysExConf::status_t::ack),
+        0x00,
+        SYSEX_CR_BULK_GET,
+        static_cast<uint8_t>(System::block_t::buttons),
+        static_cast<uint8_t>(System::Section::button_t::midiID),
+        0x00,
+        0x00,
+        0x03,
+        0x00,
+        0x0A,
+        0x00,
+        0x0B,
+        0x00,
+        0x0C,
+        0xF7
+    };
+
+    TEST_ASSERT(rawBytes == expectedGetResponse);
+#endif
+}
+
+TEST_CASE(PresetDumpAndLoad)
+{
+#ifdef BUTTONS_SUPPORTED
+    System systemStub(_hwaSystem, _database);
+
+    auto sendSysExRequest = [&](const std::vector<uint8_t> request) {
+        _hwaMIDI.usbReadPackets = MIDIHelper::rawSysExToUSBPackets(request);
+        auto packetSize         = _hwaMIDI.usbReadPackets.size();
+
+        for (size_t i = 0; i < packetSize; i++)
+            systemStub.run();
+    };
+
+    _database.factoryReset();
+    TEST_ASSERT(systemStub.init() == true);
+
+    //handshake
+    sendSysExRequest({ 0xF0,
+                       0x00,
+                       0x53,
+                       0x43,
+                       0x00,
+                       0x00,
+                       0x01,
+                       0xF7 });
+
+    //configure some values which will be dumped
+    for (size_t i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+        TEST_ASSERT(_database.update(Database::Section::button_t::midiID, i, (i * 3) & 0x7F) == true);
+
+    //values wider than 14 bits should be preserved as well
+    TEST_ASSERT(_database.update(Database::Section::button_t::dualContactCurve, 0, 0xFFFF) == true);
+
+    _hwaMIDI.reset();
+
+    sendSysExRequest({ 0xF0,
+                       0x00,
+                       0x53,
+                       0x43,
+                       0x00,
+                       0x00,
+                       SYSEX_CR_PRESET_DUMP,
+                       0xF7 });
+
+    //split the response into separate messages and convert dump messages into load requests
+    auto rawBytes = MIDIHelper::usbSysExToRawBytes(_hwaMIDI.usbWritePackets);
+
+    std::vector<std::vector<uint8_t>> loadRequests;
+    std::vector<uint8_t>              message;
+
+    for (size_t i = 0; i < rawBytes.size(); i++)
+    {
+        message.push_back(rawBytes.at(i));
+
+        if (rawBytes.at(i) == 0xF7)
+        {
+            //skip acknowledgement of custom request which has no payload
+            if ((message.size() > 8) && (message.at(6) == SYSEX_CR_PRESET_DUMP))
+            {
+                TEST_ASSERT_EQUAL_UINT32(static_cast<uint8_t>(SysExConf::status_t::ack), message.at(4));
+
+                message.at(4) = static_cast<uint8_t>(SysExConf::status_t::request);
+                message.at(6) = SYSEX_CR_PRESET_LOAD;
+                loadRequests.push_back(message);
+            }
+
+            message.clear();
+        }
+    }
+
+    //at least start, single data chunk and end
+    TEST_ASSERT(loadRequests.size() >= 3);
+    TEST_ASSERT_EQUAL_UINT32(SYSEX_PRESET_PART_START, loadRequests.front().at(5));
+    TEST_ASSERT_EQUAL_UINT32(SYSEX_PRESET_PART_END, loadRequests.back().at(5));
+
+    //change the values and then load the dump back
+    for (size_t i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+        TEST_ASSERT(_database.update(Database::Section::button_t::midiID, i, 0) == true);
+
+    TEST_ASSERT(_database.update(Database::Section::button_t::dualContactCurve, 0, 0) == true);
+
+    for (size_t i = 0; i < loadRequests.size(); i++)
+    {
+        _hwaMIDI.reset();
+        sendSysExRequest(loadRequests.at(i));
+
+        rawBytes = MIDIHelper::usbSysExToRawBytes(_hwaMIDI.usbWritePackets);
+        TEST_ASSERT(rawBytes.size() >= 8);
+        TEST_ASSERT_EQUAL_UINT32(static_cast<uint8_t>(SysExConf::status_t::ack), rawBytes.at(4));
+    }
+
+    for (size_t i = 0; i < MAX_NUMBER_OF_BUTTONS; i++)
+        TEST_ASSERT_EQUAL_UINT32((i * 3) & 0x7F, _database.read(Database::Section::button_t::midiID, i));
+
+    TEST_ASSERT_EQUAL_UINT32(0xFFFF, _database.read(Database::Section::button_t::dualContactCurve, 0));
+#endif
+}
 #endif
\ No newline at end of file
@@ -5,7 +5,7 @@
 class ButtonsFilterStub : public IO::Buttons::Filter
 {
     public:
-    bool isFiltered(size_t index, uint8_t& numberOfReadings, uint32_t& states) override
+    bool isFiltered(size_t index, const IO::Buttons::debounce_t& debounce, bool debounced, uint8_t& numberOfReadings, uint32_t& states) override
     {
         return true;
     }